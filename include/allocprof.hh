@@ -0,0 +1,65 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/* Allocation counters fed by the global operator new/delete replacements in src/allocprof.cc.  Those
+ * only exist in binaries linked with the allocprof target (-DAOC_ALLOC_PROFILE=ON); everywhere else
+ * the counters stay at zero and enabled() is false.
+ */
+namespace aoc::alloc
+{
+
+struct Counters
+{
+    std::atomic<uint64_t> allocations{};
+    std::atomic<uint64_t> bytes{};
+    std::atomic<int64_t> live{};
+    std::atomic<int64_t> peak{};
+    std::atomic<bool> interposed{};
+};
+
+inline Counters& counters()
+{
+    static Counters c;
+    return c;
+}
+
+inline bool enabled()
+{
+    return counters().interposed.load(std::memory_order_relaxed);
+}
+
+struct Stats
+{
+    uint64_t allocations{};
+    uint64_t bytes{};
+    // high-water mark of live heap above what was live when the scope began
+    uint64_t peakBytes{};
+};
+
+/// Measures allocations made anywhere in the process between construction and stop().  Scopes
+/// don't nest: starting one resets the peak watermark.
+class Scope
+{
+    uint64_t allocations;
+    uint64_t bytes;
+    int64_t live;
+
+  public:
+    Scope()
+        : allocations{counters().allocations.load()}, bytes{counters().bytes.load()},
+          live{counters().live.load()}
+    {
+        counters().peak.store(live);
+    }
+
+    [[nodiscard]] Stats stop() const
+    {
+        auto peak = counters().peak.load();
+        return {counters().allocations.load() - allocations, counters().bytes.load() - bytes,
+                peak > live ? static_cast<uint64_t>(peak - live) : 0};
+    }
+};
+
+} // namespace aoc::alloc
@@ -1,6 +1,11 @@
+#pragma once
+#include "numscan.hh"
 #include <ios>
 #include <istream>
+#include <memory>
+#include <memory_resource>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace aoc
@@ -53,6 +58,17 @@ inline std::vector<std::string> readAllLines(std::istream& input)
     return lines;
 }
 
+inline std::string slurp(std::istream& input)
+{
+    auto cur = input.tellg();
+    input.seekg(0, std::ios_base::end);
+    auto end = input.tellg();
+    input.seekg(cur, std::ios_base::beg);
+    std::string ret(end - cur, '\0');
+    input.read(ret.data(), end - cur);
+    return ret;
+}
+
 template <typename T> inline std::vector<T> readAll(std::istream& input)
 {
     std::vector<T> res;
@@ -63,15 +79,44 @@ template <typename T> inline std::vector<T> readAll(std::istream& input)
     return res;
 }
 
-inline std::string slurp(std::istream& input)
+// Integers skip the stream extractors and go through the bulk scanner.  Unlike operator>> this
+// steps over any non-numeric text rather than stopping at it.
+template <ScannableInt T> inline std::vector<T> readAll(std::istream& input)
 {
-    auto cur = input.tellg();
-    input.seekg(0, std::ios_base::end);
-    auto end = input.tellg();
-    input.seekg(cur, std::ios_base::beg);
-    std::string ret(end - cur, '\0');
-    input.read(ret.data(), end - cur);
-    return ret;
+    std::vector<T> res;
+    scanNumbers(slurp(input), res);
+    return res;
+}
+
+// pmr variants, for building the input straight into a solve's arena (see arena.hh)
+inline std::pmr::vector<std::pmr::string> readAllLines(std::istream& input,
+                                                       std::pmr::memory_resource* mr)
+{
+    std::pmr::vector<std::pmr::string> lines{mr};
+    for (std::pmr::string tmp{mr}; std::getline(input, tmp);)
+    {
+        lines.push_back(tmp);
+    }
+    return lines;
+}
+
+template <typename T> inline std::pmr::vector<T> readAll(std::istream& input,
+                                                         std::pmr::memory_resource* mr)
+{
+    std::pmr::vector<T> res{mr};
+    for (T t; input >> t;)
+    {
+        res.push_back(std::move(t));
+    }
+    return res;
+}
+
+template <ScannableInt T>
+inline std::pmr::vector<T> readAll(std::istream& input, std::pmr::memory_resource* mr)
+{
+    std::pmr::vector<T> res{mr};
+    scanNumbers(slurp(input), res);
+    return res;
 }
 
 template <size_t Y, size_t D> Solution_t<Y, D> solve(std::istream& input)
@@ -80,4 +125,33 @@ template <size_t Y, size_t D> Solution_t<Y, D> solve(std::istream& input)
     return {};
 }
 
+/* Days whose parts are independent can split themselves into a parse step and two part solvers,
+ * so the dispatcher can run the parts concurrently and the benchmark can time each on its own:
+ *
+ *     template <> struct Parsed<Y, D> { ... };
+ *     template <> std::shared_ptr<const Parsed<Y, D>> parse<Y, D>(std::istream& input);
+ *     template <> Part_t<Y, D> solvePart1<Y, D>(const Parsed<Y, D>& input);
+ *     template <> Part_t<Y, D> solvePart2<Y, D>(const Parsed<Y, D>& input);
+ *
+ * plus HasParts<Y, D> in solutions.hh and `return solveParts<Y, D>(input);` as the day's solve.
+ */
+template <size_t Y, size_t D> struct Parsed;
+
+template <size_t Y, size_t D> struct HasParts : std::false_type
+{
+};
+
+template <size_t Y, size_t D> using Part_t = decltype(Solution_t<Y, D>::part1);
+
+template <size_t Y, size_t D> std::shared_ptr<const Parsed<Y, D>> parse(std::istream& input);
+template <size_t Y, size_t D> Part_t<Y, D> solvePart1(const Parsed<Y, D>& input);
+template <size_t Y, size_t D> Part_t<Y, D> solvePart2(const Parsed<Y, D>& input);
+
+// Both parts one after the other, for callers that don't go through the dispatcher
+template <size_t Y, size_t D> Solution_t<Y, D> solveParts(std::istream& input)
+{
+    auto parsed = parse<Y, D>(input);
+    return {solvePart1<Y, D>(*parsed), solvePart2<Y, D>(*parsed)};
+}
+
 } // namespace aoc
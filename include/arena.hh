@@ -0,0 +1,112 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+/* Per-solve arena for short-lived search structures.  The dispatcher opens an ArenaScope around
+ * every solve; solvers build their containers on aoc::arena() and std::pmr, so node allocation is a
+ * pointer bump and teardown frees nothing until the scope closes.
+ *
+ * Each thread keeps its arena's first block between solves, sized to the largest solve seen so far
+ * (up to MAX_RETAINED), so repeated solves in batch or daemon mode stop going to the heap at all.
+ * Memory from the arena must not outlive the solve or cross to another thread.
+ */
+namespace aoc
+{
+
+namespace detail
+{
+// upstream for an arena that tallies what it hands out, to size the next solve's first block
+class CountingResource : public std::pmr::memory_resource
+{
+  public:
+    size_t allocated{};
+
+  private:
+    void* do_allocate(size_t bytes, size_t align) override
+    {
+        allocated += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t align) override
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& o) const noexcept override
+    {
+        return this == &o;
+    }
+};
+
+struct ThreadArena
+{
+    std::unique_ptr<std::byte[]> block; // NOLINT(*-avoid-c-arrays)
+    size_t size{};
+    std::pmr::memory_resource* current{};
+};
+
+inline ThreadArena& threadArena()
+{
+    thread_local ThreadArena arena;
+    return arena;
+}
+} // namespace detail
+
+/// The arena of the solve running on this thread, or the default heap outside of any solve
+inline std::pmr::memory_resource* arena()
+{
+    auto* current = detail::threadArena().current;
+    return current != nullptr ? current : std::pmr::new_delete_resource();
+}
+
+/// Makes arena() a fresh monotonic arena for the current thread until destroyed.  Scopes nest;
+/// only the outermost reuses the thread's retained block.
+class ArenaScope
+{
+    static constexpr size_t INITIAL_BLOCK = size_t{64} << 10U;
+    static constexpr size_t MAX_RETAINED = size_t{256} << 20U;
+
+    detail::CountingResource upstream;
+    std::optional<std::pmr::monotonic_buffer_resource> resource;
+    std::pmr::memory_resource* previous;
+
+  public:
+    ArenaScope() : previous{detail::threadArena().current}
+    {
+        auto& t = detail::threadArena();
+        if (previous == nullptr && t.block)
+        {
+            resource.emplace(t.block.get(), t.size, &upstream);
+        }
+        else
+        {
+            resource.emplace(INITIAL_BLOCK, &upstream);
+        }
+        t.current = &*resource;
+    }
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope(ArenaScope&&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+    ArenaScope& operator=(ArenaScope&&) = delete;
+    ~ArenaScope()
+    {
+        auto& t = detail::threadArena();
+        t.current = previous;
+        resource.reset();
+        if (previous != nullptr || upstream.allocated == 0)
+        {
+            return;
+        }
+        // the solve overflowed the retained block: keep one big enough for all of it next time
+        auto wanted = std::min(t.size + upstream.allocated, MAX_RETAINED);
+        if (wanted > t.size)
+        {
+            t.block = std::make_unique_for_overwrite<std::byte[]>(wanted); // NOLINT(*-c-arrays)
+            t.size = wanted;
+        }
+    }
+};
+
+} // namespace aoc
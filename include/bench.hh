@@ -0,0 +1,145 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace aoc::bench
+{
+
+struct Options
+{
+    size_t warmup = 1;
+    size_t reps = 10;
+};
+
+// All figures in microseconds
+struct Summary
+{
+    size_t samples{};
+    double min{};
+    double median{};
+    double p95{};
+    double mean{};
+    double stddev{};
+};
+
+// nearest-rank percentile of an already sorted sample
+inline double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+    auto rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+    return sorted[std::clamp(rank, 1UZ, sorted.size()) - 1];
+}
+
+inline Summary summarize(std::vector<double> samples)
+{
+    Summary s;
+    s.samples = samples.size();
+    if (samples.empty())
+    {
+        return s;
+    }
+    std::ranges::sort(samples);
+    auto n = static_cast<double>(samples.size());
+    s.min = samples.front();
+    auto mid = samples.size() / 2;
+    s.median = samples.size() % 2 ? samples[mid] : (samples[mid - 1] + samples[mid]) / 2;
+    constexpr double P95 = 95;
+    s.p95 = percentile(samples, P95);
+    s.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+    if (samples.size() > 1)
+    {
+        auto sq = std::accumulate(samples.begin(), samples.end(), 0.0,
+                                  [m = s.mean](double acc, double x)
+                                  { return acc + (x - m) * (x - m); });
+        s.stddev = std::sqrt(sq / (n - 1));
+    }
+    return s;
+}
+
+/// One-sided Mann-Whitney U test: the p-value for `current` being drawn from a distribution that
+/// is stochastically larger than that of `baseline`.  Normal approximation with tie and continuity
+/// correction, which is reasonable from about 8 samples a side.  1 when either side is empty.
+inline double mannWhitneyGreater(const std::vector<double>& baseline,
+                                 const std::vector<double>& current)
+{
+    if (baseline.empty() || current.empty())
+    {
+        return 1;
+    }
+    // (value, from current) sorted, ties share the average of their ranks
+    std::vector<std::pair<double, bool>> pooled;
+    pooled.reserve(baseline.size() + current.size());
+    for (auto x : baseline)
+    {
+        pooled.emplace_back(x, false);
+    }
+    for (auto x : current)
+    {
+        pooled.emplace_back(x, true);
+    }
+    std::ranges::sort(pooled);
+    auto n = static_cast<double>(pooled.size());
+    double rankSum = 0;
+    double tieTerm = 0;
+    for (size_t i = 0; i < pooled.size();)
+    {
+        auto j = i;
+        while (j < pooled.size() && pooled[j].first == pooled[i].first)
+        {
+            ++j;
+        }
+        // ranks i+1 .. j
+        auto rank = static_cast<double>(i + 1 + j) / 2;
+        auto t = static_cast<double>(j - i);
+        tieTerm += t * t * t - t;
+        for (auto k = i; k < j; ++k)
+        {
+            rankSum += pooled[k].second ? rank : 0;
+        }
+        i = j;
+    }
+    auto n1 = static_cast<double>(current.size());
+    auto n2 = static_cast<double>(baseline.size());
+    auto u = rankSum - n1 * (n1 + 1) / 2;
+    auto mean = n1 * n2 / 2;
+    auto variance = n1 * n2 / 12 * ((n + 1) - tieTerm / (n * (n - 1))); // NOLINT(*-magic-numbers)
+    if (variance <= 0)
+    {
+        return 1;
+    }
+    auto z = (u - mean - 0.5) / std::sqrt(variance);
+    return std::erfc(z / std::sqrt(2.0)) / 2;
+}
+
+/// Runs `setup` then `f` opts.warmup times untimed, then opts.reps times timed.  Only `f` is
+/// inside the clock, so `setup` is where callers rewind their input.
+template <typename Setup, typename F>
+std::vector<double> measure(const Options& opts, Setup&& setup, F&& f)
+{
+    for (size_t i = 0; i < opts.warmup; ++i)
+    {
+        setup();
+        f();
+    }
+    std::vector<double> samples;
+    samples.reserve(opts.reps);
+    for (size_t i = 0; i < opts.reps; ++i)
+    {
+        setup();
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    return samples;
+}
+
+} // namespace aoc::bench
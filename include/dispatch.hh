@@ -1,14 +1,50 @@
 #pragma once
+#include "input.hh"
+#include <array>
 #include <cstddef>
+#include <filesystem>
 #include <istream>
+#include <memory>
 #include <string>
 #include <utility>
 
 namespace aoc
 {
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
+inline constexpr std::array<size_t, 6> YEARS = {2015, 2016, 2017, 2018, 2024, 2025};
+inline constexpr size_t NUM_DAYS = 25;
+
 /// Runs the registered solver for (year, day) and returns {part1, part2} as strings.
-/// Returns {"", ""} for unregistered (year, day) pairs.
+/// Returns {"", ""} for unregistered (year, day) pairs.  The solve gets a fresh aoc::arena(),
+/// recycled by the calling thread for its next solve.
+std::pair<std::string, std::string> runSolver(size_t year, size_t day, const InputView& input);
 std::pair<std::string, std::string> runSolver(size_t year, size_t day, std::istream& input);
+/// Same for an input file.  Streaming days (IsStreaming) read it in chunks as they go instead of
+/// mapping all of it.
+std::pair<std::string, std::string> runSolver(size_t year, size_t day,
+                                              const std::filesystem::path& path);
+
+/// Parse result of a day that implements split parts (HasParts), for running the parts one at a
+/// time.  Empty for every other day.
+struct ParsedInput
+{
+    size_t year{};
+    size_t day{};
+    std::shared_ptr<const void> data;
+
+    explicit operator bool() const
+    {
+        return data != nullptr;
+    }
+};
+
+ParsedInput parseInput(size_t year, size_t day, const InputView& input);
+
+/// Runs part 1 or 2 alone over a non-empty parseInput result
+std::string runPart(const ParsedInput& parsed, int part);
+
+/// Whether (year, day) is flagged IsSlow.  False for unregistered pairs.
+bool isSlow(size_t year, size_t day);
 
 } // namespace aoc
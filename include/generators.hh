@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string_view>
+
+/* Synthetic puzzle inputs at arbitrary scale, for seeing how solvers grow with n.  Every generator
+ * is deterministic in (scale, seed) and writes input the day's solver accepts; what "scale" counts
+ * is given by each generator's description.
+ */
+namespace aoc::gen
+{
+
+struct Generator
+{
+    size_t year;
+    size_t day;
+    // what the scale parameter counts
+    std::string_view description;
+    // roughly the size of a real puzzle input
+    size_t puzzleScale;
+    void (*write)(std::ostream& os, size_t scale, uint64_t seed);
+};
+
+std::span<const Generator> generators();
+
+/// nullptr when (year, day) has no generator
+const Generator* findGenerator(size_t year, size_t day);
+
+} // namespace aoc::gen
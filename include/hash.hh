@@ -1,6 +1,9 @@
 #pragma once
 #include <array>
+#include <cstdint>
 #include <openssl/evp.h>
+#include <stdexcept>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -130,9 +133,34 @@ class Hasher
         return ret;
     }
 
+    // The algorithm is fetched once per process and shared by reference count; the fetch walks
+    // the provider tables under a lock, which dominates the cost of a fresh Hasher
     static Hasher md5Hasher()
     {
-        return Hasher{EVP_MD_fetch(nullptr, "MD5", nullptr)};
+        static EVP_MD* const FETCHED = EVP_MD_fetch(nullptr, "MD5", nullptr);
+        if (FETCHED == nullptr || !EVP_MD_up_ref(FETCHED))
+        {
+            throw std::runtime_error{"Failed to fetch MD5"};
+        }
+        return Hasher{FETCHED};
+    }
+
+    // one per thread, reused across calls: fetching the digest and allocating its context costs
+    // more than hashing a short message
+    static Hasher& threadMd5()
+    {
+        thread_local Hasher hasher = md5Hasher();
+        return hasher;
+    }
+
+    static Hasher sha256Hasher()
+    {
+        static EVP_MD* const FETCHED = EVP_MD_fetch(nullptr, "SHA256", nullptr);
+        if (FETCHED == nullptr || !EVP_MD_up_ref(FETCHED))
+        {
+            throw std::runtime_error{"Failed to fetch SHA256"};
+        }
+        return Hasher{FETCHED};
     }
 };
 } // namespace Hash
\ No newline at end of file
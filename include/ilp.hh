@@ -0,0 +1,666 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "matrix.hh"
+#include "rational.hh"
+
+/* Small integer linear programs: minimise cost . x over integer x with A x = b and
+ * 0 <= x <= upper.  Branch and bound over LP relaxations, each solved exactly by a two phase
+ * simplex on a Matrix<Rational<int64_t>> tableau with Bland's rule, so there's no tolerance to
+ * tune and no cycling.  A node is pruned once its relaxation can't beat the best integer solution
+ * so far, which is what keeps problems with many free variables to a handful of nodes.
+ *
+ * Costs are integers, so a node is only worth exploring while its relaxation is at most the
+ * incumbent minus one.  Sized for dozens of variables and constraints with small coefficients:
+ * the tableau is dense, and its entries and the lattice's grow with the subdeterminants of A.
+ * Every one of those computations is checked, Release builds included, so a problem that outgrows
+ * int64 throws std::overflow_error rather than coming back with a wrong answer.
+ */
+namespace aoc::ilp
+{
+using Q = Rational<int64_t, true>;
+
+struct Problem
+{
+    std::vector<std::vector<int64_t>> equalities;
+    std::vector<int64_t> rhs;
+    std::vector<int64_t> upper;
+    std::vector<int64_t> cost;
+};
+
+struct Solution
+{
+    int64_t value;
+    std::vector<int64_t> x;
+};
+
+namespace detail
+{
+[[noreturn]] inline void outgrown()
+{
+    throw std::overflow_error("ilp: coefficients outgrew int64");
+}
+
+// int64 arithmetic for the lattice and the tableau's setup, which throws instead of wrapping
+inline int64_t add(int64_t a, int64_t b)
+{
+    int64_t r{};
+    if (__builtin_add_overflow(a, b, &r))
+    {
+        outgrown();
+    }
+    return r;
+}
+inline int64_t sub(int64_t a, int64_t b)
+{
+    int64_t r{};
+    if (__builtin_sub_overflow(a, b, &r))
+    {
+        outgrown();
+    }
+    return r;
+}
+inline int64_t mul(int64_t a, int64_t b)
+{
+    int64_t r{};
+    if (__builtin_mul_overflow(a, b, &r))
+    {
+        outgrown();
+    }
+    return r;
+}
+
+inline int64_t floor(Q q)
+{
+    auto t = static_cast<int64_t>(q);
+    return Q{t} > q ? t - 1 : t;
+}
+
+inline int64_t ceil(Q q)
+{
+    auto t = static_cast<int64_t>(q);
+    return Q{t} < q ? t + 1 : t;
+}
+
+struct Relaxation
+{
+    Q value;
+    std::vector<Q> x;
+};
+
+/* Tableau for A y = b - A lower, y + s = upper - lower, with an artificial variable per equality.
+ * Columns are y, then s, then the artificials, then the right hand side; the last row holds the
+ * reduced costs, with minus the objective in its last column.
+ */
+class Simplex
+{
+    size_t n;
+    size_t m;
+    Matrix<Q> t;
+    std::vector<size_t> basis;
+
+    [[nodiscard]] size_t rhs() const
+    {
+        return t.cols() - 1;
+    }
+    [[nodiscard]] size_t objective() const
+    {
+        return t.rows() - 1;
+    }
+    [[nodiscard]] size_t artificial(size_t i) const
+    {
+        return 2 * n + i;
+    }
+
+    void pivot(size_t r, size_t c)
+    {
+        t.scaleRow(r, Q{1} / t(r, c));
+        for (size_t i = 0; i < t.rows(); i++)
+        {
+            if (i != r && t(i, c) != 0)
+            {
+                t.addRows(r, i, -t(i, c));
+            }
+        }
+        basis[r] = c;
+    }
+
+    // Bland's rule: lowest column that improves, then the lowest basic variable among ties
+    void optimise(size_t columns)
+    {
+        for (;;)
+        {
+            size_t c = 0;
+            while (c < columns && t(objective(), c) >= 0)
+            {
+                c++;
+            }
+            if (c == columns)
+            {
+                return;
+            }
+            std::optional<size_t> leave;
+            Q best;
+            for (size_t r = 0; r < objective(); r++)
+            {
+                if (t(r, c) <= 0)
+                {
+                    continue;
+                }
+                auto ratio = t(r, rhs()) / t(r, c);
+                if (!leave || ratio < best || (ratio == best && basis[r] < basis[*leave]))
+                {
+                    leave = r;
+                    best = ratio;
+                }
+            }
+            // every variable is bounded, so some row always limits the entering one
+            pivot(*leave, c);
+        }
+    }
+
+    // reduced costs and objective for `cost` (indexed by column) over the current basis
+    void price(const std::vector<Q>& cost)
+    {
+        for (size_t c = 0; c < t.cols(); c++)
+        {
+            Q reduced = c < cost.size() ? cost[c] : Q{};
+            for (size_t r = 0; r < objective(); r++)
+            {
+                if (basis[r] < cost.size() && t(r, c) != 0)
+                {
+                    reduced -= cost[basis[r]] * t(r, c);
+                }
+            }
+            t(objective(), c) = reduced;
+        }
+    }
+
+  public:
+    Simplex(const Problem& p, const std::vector<int64_t>& lower, const std::vector<int64_t>& upper)
+        : n{p.cost.size()}, m{p.rhs.size()}, t{m + n + 1, 2 * n + m + 1}, basis(m + n)
+    {
+        for (size_t i = 0; i < m; i++)
+        {
+            int64_t b = p.rhs[i];
+            for (size_t j = 0; j < n; j++)
+            {
+                b = sub(b, mul(p.equalities[i][j], lower[j]));
+            }
+            // artificials start basic at b, which has to be non-negative
+            int64_t sign = b < 0 ? -1 : 1;
+            for (size_t j = 0; j < n; j++)
+            {
+                t(i, j) = sign * p.equalities[i][j];
+            }
+            t(i, artificial(i)) = 1;
+            t(i, rhs()) = mul(sign, b);
+            basis[i] = artificial(i);
+        }
+        for (size_t j = 0; j < n; j++)
+        {
+            t(m + j, j) = 1;
+            t(m + j, n + j) = 1;
+            t(m + j, rhs()) = sub(upper[j], lower[j]);
+            basis[m + j] = n + j;
+        }
+    }
+
+    std::optional<Relaxation> solve(const std::vector<int64_t>& cost,
+                                    const std::vector<int64_t>& lower)
+    {
+        // phase 1: drive the artificials to 0
+        std::vector<Q> phase1(t.cols() - 1);
+        for (size_t i = 0; i < m; i++)
+        {
+            phase1[artificial(i)] = 1;
+        }
+        price(phase1);
+        optimise(t.cols() - 1);
+        if (t(objective(), rhs()) != 0)
+        {
+            return {};
+        }
+        // swap out artificials still basic at 0, in a bound row as much as an equality's; a row
+        // with nothing else to pivot on is redundant
+        for (size_t r = 0; r < objective(); r++)
+        {
+            if (basis[r] < 2 * n)
+            {
+                continue;
+            }
+            for (size_t c = 0; c < 2 * n; c++)
+            {
+                if (t(r, c) != 0)
+                {
+                    pivot(r, c);
+                    break;
+                }
+            }
+        }
+
+        // phase 2: the real objective, artificials can't re-enter
+        std::vector<Q> phase2(2 * n);
+        std::ranges::copy(cost, phase2.begin());
+        price(phase2);
+        optimise(2 * n);
+
+        Relaxation res{-t(objective(), rhs()), std::vector<Q>(n)};
+        for (size_t j = 0; j < n; j++)
+        {
+            res.x[j] = lower[j];
+            res.value += Q{mul(cost[j], lower[j])};
+        }
+        for (size_t r = 0; r < objective(); r++)
+        {
+            if (basis[r] < n)
+            {
+                res.x[basis[r]] += t(r, rhs());
+            }
+        }
+        return res;
+    }
+};
+
+/* Every integer solution of A x = b, as x = x0 + K z for integer z.  Unimodular column operations
+ * (extended gcd steps) take A to A U = [L 0] with L lower triangular, so x = U w and L w = b fix
+ * the leading w while the rest, z, are free: x0 is U applied to the fixed part and K is the rest
+ * of U.  The rows of U's inverse that give z back from x are kept too, so the range z can take
+ * over the relaxation can be found by LP.
+ */
+struct Lattice
+{
+    std::vector<int64_t> x0;
+    std::vector<std::vector<int64_t>> kernel; // kernel[j][i]: x_j per unit of z_i
+    std::vector<std::vector<int64_t>> coords; // coords[i][j]: z_i per unit of x_j
+
+    static std::optional<Lattice> of(const Problem& p)
+    {
+        auto n = p.cost.size();
+        auto a = p.equalities;
+        std::vector<std::vector<int64_t>> u(n, std::vector<int64_t>(n));
+        auto inv = u;
+        for (size_t j = 0; j < n; j++)
+        {
+            u[j][j] = inv[j][j] = 1;
+        }
+        // [col c, col d] <- [col c, col d] [[s, -b/g], [t, a/g]], and the inverse on inv's rows
+        auto combine = [&](size_t c, size_t d, int64_t s, int64_t t, int64_t ag, int64_t bg)
+        {
+            for (auto* m : {&a, &u})
+            {
+                for (auto& row : *m)
+                {
+                    auto x = row[c];
+                    auto y = row[d];
+                    row[c] = add(mul(s, x), mul(t, y));
+                    row[d] = sub(mul(ag, y), mul(bg, x));
+                }
+            }
+            for (size_t j = 0; j < n; j++)
+            {
+                auto x = inv[c][j];
+                auto y = inv[d][j];
+                inv[c][j] = add(mul(ag, x), mul(bg, y));
+                inv[d][j] = sub(mul(s, y), mul(t, x));
+            }
+        };
+
+        size_t rank = 0;
+        std::vector<std::optional<size_t>> pivotOf(a.size());
+        for (size_t i = 0; i < a.size() && rank < n; i++)
+        {
+            for (size_t d = rank + 1; d < n; d++)
+            {
+                if (a[i][d] == 0)
+                {
+                    continue;
+                }
+                auto [g, s, t] = extendedGcd(a[i][rank], a[i][d]);
+                combine(rank, d, s, t, a[i][rank] / g, a[i][d] / g);
+            }
+            if (a[i][rank] != 0)
+            {
+                pivotOf[i] = rank++;
+            }
+        }
+
+        // L w = b by forward substitution, each pivot has to divide exactly
+        std::vector<int64_t> w(n);
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            int64_t rest = p.rhs[i];
+            for (size_t c = 0; c < rank; c++)
+            {
+                if (c != pivotOf[i])
+                {
+                    rest = sub(rest, mul(a[i][c], w[c]));
+                }
+            }
+            if (!pivotOf[i])
+            {
+                if (rest != 0)
+                {
+                    return {};
+                }
+                continue;
+            }
+            auto c = *pivotOf[i];
+            if (rest % a[i][c] != 0)
+            {
+                return {};
+            }
+            w[c] = rest / a[i][c];
+        }
+
+        Lattice res{std::vector<int64_t>(n), std::vector<std::vector<int64_t>>(n),
+                    std::vector<std::vector<int64_t>>(n - rank)};
+        for (size_t j = 0; j < n; j++)
+        {
+            for (size_t c = 0; c < rank; c++)
+            {
+                res.x0[j] = add(res.x0[j], mul(u[j][c], w[c]));
+            }
+            res.kernel[j].assign(std::next(u[j].begin(), static_cast<std::ptrdiff_t>(rank)),
+                                 u[j].end());
+        }
+        for (size_t i = 0; i < n - rank; i++)
+        {
+            res.coords[i] = inv[rank + i];
+        }
+        res.reduce();
+        return res;
+    }
+
+  private:
+    // LLL (delta 3/4) on the kernel's columns, so z steps along short, nearly orthogonal vectors.
+    // The Gram-Schmidt data is only a guide, in doubles; the basis changes themselves are exact.
+    void reduce()
+    {
+        auto f = coords.size();
+        auto column = [&](size_t i)
+        {
+            std::vector<double> v(kernel.size());
+            for (size_t j = 0; j < kernel.size(); j++)
+            {
+                v[j] = static_cast<double>(kernel[j][i]);
+            }
+            return v;
+        };
+        auto dot = [](const std::vector<double>& l, const std::vector<double>& r)
+        { return std::inner_product(l.begin(), l.end(), r.begin(), 0.0); };
+        // b_k -= q b_i, so z_i += q z_k
+        auto subtract = [&](size_t k, size_t i, int64_t q)
+        {
+            for (auto& row : kernel)
+            {
+                row[k] = sub(row[k], mul(q, row[i]));
+            }
+            for (size_t j = 0; j < coords[i].size(); j++)
+            {
+                coords[i][j] = add(coords[i][j], mul(q, coords[k][j]));
+            }
+        };
+        auto swap = [&](size_t k, size_t i)
+        {
+            for (auto& row : kernel)
+            {
+                std::swap(row[k], row[i]);
+            }
+            std::swap(coords[k], coords[i]);
+        };
+
+        constexpr double DELTA = 0.75;
+        // a little over 1/2, or rounding can flip a coefficient of exactly 1/2 back and forth
+        constexpr double ETA = 0.51;
+        for (size_t k = 1; k < f;)
+        {
+            // Gram-Schmidt of the first k + 1 columns
+            std::vector<std::vector<double>> star;
+            std::vector<std::vector<double>> mu(k + 1, std::vector<double>(k + 1));
+            for (size_t i = 0; i <= k; i++)
+            {
+                auto v = column(i);
+                for (size_t j = 0; j < i; j++)
+                {
+                    mu[i][j] = dot(column(i), star[j]) / dot(star[j], star[j]);
+                    for (size_t e = 0; e < v.size(); e++)
+                    {
+                        v[e] -= mu[i][j] * star[j][e];
+                    }
+                }
+                star.push_back(std::move(v));
+            }
+            bool changed = false;
+            for (size_t j = k; j-- > 0;)
+            {
+                if (std::abs(mu[k][j]) > ETA)
+                {
+                    // past 2^53 the doubles can't guide the exact steps any more
+                    if (std::abs(mu[k][j]) > 0x1p53)
+                    {
+                        outgrown();
+                    }
+                    auto q = static_cast<int64_t>(std::llround(mu[k][j]));
+                    subtract(k, j, q);
+                    for (size_t e = 0; e <= j; e++)
+                    {
+                        mu[k][e] -= static_cast<double>(q) * (e == j ? 1.0 : mu[j][e]);
+                    }
+                    changed = true;
+                }
+            }
+            if (changed)
+            {
+                // recompute with the size reduced column before the exchange test
+                continue;
+            }
+            auto lovasz = (DELTA - mu[k][k - 1] * mu[k][k - 1]) * dot(star[k - 1], star[k - 1]);
+            if (dot(star[k], star[k]) < lovasz)
+            {
+                swap(k, k - 1);
+                k = std::max<size_t>(k - 1, 1);
+            }
+            else
+            {
+                k++;
+            }
+        }
+    }
+
+    // g = gcd(a, b) > 0 with s a + t b = g, for a and b not both 0
+    static std::tuple<int64_t, int64_t, int64_t> extendedGcd(int64_t a, int64_t b)
+    {
+        int64_t s0 = 1, s1 = 0, t0 = 0, t1 = 1; // NOLINT(readability-isolate-declaration)
+        while (b != 0)
+        {
+            auto q = a / b;
+            std::tie(a, b) = std::pair{b, sub(a, mul(q, b))};
+            std::tie(s0, s1) = std::pair{s1, sub(s0, mul(q, s1))};
+            std::tie(t0, t1) = std::pair{t1, sub(t0, mul(q, t1))};
+        }
+        if (a < 0)
+        {
+            return {-a, -s0, -t0};
+        }
+        return {a, s0, t0};
+    }
+};
+
+/* Depth first branch and bound.  Only variables from `integral` on are branched on: the caller
+ * sets the problem up so that those being whole makes the rest whole.
+ */
+class BranchAndBound
+{
+    const Problem& p;
+    size_t integral;
+    std::optional<Solution> best;
+
+    void branch(std::vector<int64_t>& lower, std::vector<int64_t>& upper)
+    {
+        for (size_t j = 0; j < lower.size(); j++)
+        {
+            if (lower[j] > upper[j])
+            {
+                return;
+            }
+        }
+        auto lp = Simplex{p, lower, upper}.solve(p.cost, lower);
+        if (!lp || (best && ceil(lp->value) >= best->value))
+        {
+            return;
+        }
+        // branch on the most fractional variable
+        std::optional<size_t> split;
+        Q splitDistance;
+        for (size_t j = integral; j < lp->x.size(); j++)
+        {
+            auto frac = lp->x[j] - Q{floor(lp->x[j])};
+            auto distance = std::min(frac, Q{1} - frac);
+            if (frac != 0 && (!split || distance > splitDistance))
+            {
+                split = j;
+                splitDistance = distance;
+            }
+        }
+        if (!split)
+        {
+            Solution s{static_cast<int64_t>(lp->value), {}};
+            std::ranges::transform(lp->x, std::back_inserter(s.x),
+                                   [](auto v) { return static_cast<int64_t>(v); });
+            best = std::move(s);
+            return;
+        }
+        auto j = *split;
+        auto down = floor(lp->x[j]);
+        // the side the relaxation leans to first, it's the likelier place for a good incumbent
+        bool upFirst = lp->x[j] - Q{down} > Q{1, 2};
+        for (bool up : {upFirst, !upFirst})
+        {
+            auto& bound = up ? lower[j] : upper[j];
+            auto saved = bound;
+            bound = up ? down + 1 : down;
+            branch(lower, upper);
+            bound = saved;
+        }
+    }
+
+  public:
+    BranchAndBound(const Problem& p, size_t integral) : p{p}, integral{integral} {}
+
+    std::optional<Solution> solve() &&
+    {
+        std::vector<int64_t> lower(p.cost.size());
+        auto upper = p.upper;
+        branch(lower, upper);
+        return std::move(best);
+    }
+};
+
+// the best integer point of p, reformulated over its lattice of integer solutions
+inline std::optional<Solution> latticeSearch(const Problem& p)
+{
+    auto lattice = Lattice::of(p);
+    if (!lattice)
+    {
+        return {};
+    }
+    auto n = p.cost.size();
+    auto free = lattice->coords.size();
+    std::vector<int64_t> zeros(n);
+
+    // The lattice coordinates are branched on instead of x: x is whole whenever they are, while
+    // x_j being whole says nothing about the others.  Their range over the relaxation bounds them.
+    // Then x - K y = x0 + K zMin, with z = zMin + y, replaces A x = b.
+    std::vector<int64_t> zMin(free);
+    std::vector<int64_t> zMax(free);
+    for (size_t i = 0; i < free; i++)
+    {
+        auto& g = lattice->coords[i];
+        std::vector<int64_t> negated(n);
+        std::ranges::transform(g, negated.begin(), [](auto v) { return -v; });
+        auto low = Simplex{p, zeros, p.upper}.solve(g, zeros);
+        auto high = Simplex{p, zeros, p.upper}.solve(negated, zeros);
+        if (!low || !high)
+        {
+            return {};
+        }
+        zMin[i] = ceil(low->value);
+        zMax[i] = floor(-high->value);
+    }
+
+    Problem shifted;
+    shifted.cost = p.cost;
+    shifted.cost.resize(n + free);
+    shifted.upper = p.upper;
+    for (size_t i = 0; i < free; i++)
+    {
+        shifted.upper.push_back(sub(zMax[i], zMin[i]));
+    }
+    for (size_t j = 0; j < n; j++)
+    {
+        auto& row = shifted.equalities.emplace_back(n + free);
+        row[j] = 1;
+        int64_t rhs = lattice->x0[j];
+        for (size_t i = 0; i < free; i++)
+        {
+            row[n + i] = -lattice->kernel[j][i];
+            rhs = add(rhs, mul(lattice->kernel[j][i], zMin[i]));
+        }
+        shifted.rhs.push_back(rhs);
+    }
+    if (std::ranges::any_of(shifted.upper, [](auto u) { return u < 0; }))
+    {
+        return {};
+    }
+
+    auto best = BranchAndBound{shifted, n}.solve();
+    if (best)
+    {
+        best->x.resize(n);
+    }
+    return best;
+}
+} // namespace detail
+
+/// The integer x minimising cost . x with 0 <= x <= upper and equalities . x = rhs, if there is
+/// one.  Throws std::overflow_error for a problem whose arithmetic doesn't fit in int64.
+inline std::optional<Solution> minimize(const Problem& p)
+{
+    // The relaxation's optimum is often a whole face of the polytope, and when that face holds no
+    // integer point every node on it ties the bound and none can be pruned.  So the objective is
+    // fixed one value at a time from the relaxation's bound up, as one more equality: a value with
+    // no integer solution at all fails in the lattice setup, and the first that succeeds is optimal
+    std::vector<int64_t> zeros(p.cost.size());
+    std::vector<int64_t> negated(p.cost.size());
+    std::ranges::transform(p.cost, negated.begin(), [](auto v) { return -v; });
+    auto low = detail::Simplex{p, zeros, p.upper}.solve(p.cost, zeros);
+    auto high = detail::Simplex{p, zeros, p.upper}.solve(negated, zeros);
+    if (!low || !high)
+    {
+        return {};
+    }
+    auto slice = p;
+    slice.equalities.push_back(p.cost);
+    slice.rhs.push_back(0);
+    for (auto v = detail::ceil(low->value); v <= detail::floor(-high->value); v++)
+    {
+        slice.rhs.back() = v;
+        if (auto best = detail::latticeSearch(slice))
+        {
+            return best;
+        }
+    }
+    return {};
+}
+
+} // namespace aoc::ilp
@@ -0,0 +1,168 @@
+#pragma once
+#include "aoc.hh"
+#include <cerrno>
+#include <fcntl.h>
+#include <filesystem>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#include <vector>
+
+namespace aoc
+{
+
+/// Read-only puzzle input.  Either a private mmap of a file, an owned copy of a stream's contents,
+/// or a borrowed buffer.  The line index is built on first use and shared by every caller.
+class InputView
+{
+  public:
+    explicit InputView(std::string_view borrowed) : text_{borrowed} {}
+
+    static InputView open(const std::filesystem::path& path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            throw std::system_error{errno, std::generic_category(), path.string()};
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) != 0)
+        {
+            auto err = errno;
+            ::close(fd);
+            throw std::system_error{err, std::generic_category(), path.string()};
+        }
+        auto size = static_cast<size_t>(st.st_size);
+        InputView view{std::string_view{}};
+        // mmap rejects zero-length mappings, an empty file is just an empty view
+        if (size > 0)
+        {
+            void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+            if (addr == MAP_FAILED)
+            {
+                auto err = errno;
+                ::close(fd);
+                throw std::system_error{err, std::generic_category(), path.string()};
+            }
+            ::madvise(addr, size, MADV_SEQUENTIAL);
+            view.mapping = std::shared_ptr<void>{addr, [size](void* p) { ::munmap(p, size); }};
+            view.text_ = {static_cast<const char*>(addr), size};
+        }
+        ::close(fd);
+        return view;
+    }
+
+    static InputView fromStream(std::istream& input)
+    {
+        auto owned = std::make_shared<std::string>(slurp(input));
+        InputView view{std::string_view{*owned}};
+        view.mapping = std::move(owned);
+        return view;
+    }
+
+    [[nodiscard]] std::string_view text() const
+    {
+        return text_;
+    }
+
+    /// Same split as readAllLines: on '\n', with no trailing empty line after a final newline
+    [[nodiscard]] const std::vector<std::string_view>& lines() const
+    {
+        std::call_once(index->once,
+                       [this]
+                       {
+                           for (size_t pos = 0; pos < text_.size();)
+                           {
+                               auto nl = text_.find('\n', pos);
+                               if (nl == std::string_view::npos)
+                               {
+                                   nl = text_.size();
+                               }
+                               index->lines.push_back(text_.substr(pos, nl - pos));
+                               pos = nl + 1;
+                           }
+                       });
+        return index->lines;
+    }
+
+  private:
+    struct LineIndex
+    {
+        std::once_flag once;
+        std::vector<std::string_view> lines;
+    };
+
+    std::string_view text_;
+    // keeps the mmap or owned copy alive; shared so views can be handed to concurrent tasks
+    std::shared_ptr<void> mapping;
+    std::shared_ptr<LineIndex> index = std::make_shared<LineIndex>();
+};
+
+/// std::istream over an InputView's buffer without copying it.  Supports seeking so that slurp and
+/// friends behave exactly as they do on an ifstream.
+class ViewStream : public std::istream
+{
+    struct Buf : std::streambuf
+    {
+        explicit Buf(std::string_view text)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast) get area is never written
+            auto* p = const_cast<char*>(text.data());
+            setg(p, p, std::next(p, static_cast<std::ptrdiff_t>(text.size())));
+        }
+
+      protected:
+        pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                         std::ios_base::openmode which) override
+        {
+            if (!(which & std::ios_base::in))
+            {
+                return pos_type(off_type(-1));
+            }
+            off_type base{};
+            switch (dir)
+            {
+            case std::ios_base::beg: base = 0; break;
+            case std::ios_base::cur: base = gptr() - eback(); break;
+            case std::ios_base::end: base = egptr() - eback(); break;
+            default: return pos_type(off_type(-1));
+            }
+            auto target = base + off;
+            if (target < 0 || target > egptr() - eback())
+            {
+                return pos_type(off_type(-1));
+            }
+            setg(eback(), std::next(eback(), target), egptr());
+            return pos_type(target);
+        }
+
+        pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+        {
+            return seekoff(off_type(pos), std::ios_base::beg, which);
+        }
+    };
+
+    Buf buf;
+
+  public:
+    explicit ViewStream(const InputView& input) : std::istream{nullptr}, buf{input.text()}
+    {
+        rdbuf(&buf);
+    }
+};
+
+// Days that don't take an InputView directly see it through a stream
+template <size_t Y, size_t D> Solution_t<Y, D> solve(const InputView& input)
+{
+    ViewStream is{input};
+    return solve<Y, D>(static_cast<std::istream&>(is));
+}
+
+} // namespace aoc
@@ -0,0 +1,230 @@
+#pragma once
+#include "aoc.hh"
+#include <array>
+#include <cerrno>
+#include <condition_variable>
+#include <fcntl.h>
+#include <filesystem>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+/* Chunked input for days that only need one pass over it, so they run in constant memory however
+ * large the input.  A day keeps its parser state in a struct with a feed(std::string_view) member,
+ * written so that chunks may split the input anywhere (and optionally finish(), for whatever is
+ * left over at the end), and drives it with parseStream:
+ *
+ *     template <> struct IsStreaming<Y, D> : std::true_type {};            // solutions.hh
+ *     template <> Solution_t<Y, D> solve<Y, D>(InputStream& input)
+ *     {
+ *         auto state = parseStream<State>(input);
+ *         ...
+ *     }
+ *
+ * The dispatcher then reads files for that day through a FileStream instead of mapping them.
+ */
+namespace aoc
+{
+
+class InputStream
+{
+  public:
+    static constexpr size_t CHUNK = size_t{1} << 20U;
+
+    InputStream() = default;
+    InputStream(const InputStream&) = delete;
+    InputStream(InputStream&&) = delete;
+    InputStream& operator=(const InputStream&) = delete;
+    InputStream& operator=(InputStream&&) = delete;
+    virtual ~InputStream() = default;
+
+    /// The next piece of input, empty once it's exhausted.  Valid until the following call.
+    virtual std::string_view next() = 0;
+};
+
+/// A buffer already in memory, handed over in one piece
+class MemoryStream : public InputStream
+{
+    std::string_view text;
+
+  public:
+    explicit MemoryStream(std::string_view text) : text{text} {}
+
+    std::string_view next() override
+    {
+        return std::exchange(text, {});
+    }
+};
+
+/// Chunks read from a std::istream
+class IstreamStream : public InputStream
+{
+    std::istream& is;
+    std::vector<char> buf = std::vector<char>(CHUNK);
+
+  public:
+    explicit IstreamStream(std::istream& is) : is{is} {}
+
+    std::string_view next() override
+    {
+        is.read(buf.data(), static_cast<std::streamsize>(buf.size()));
+        return {buf.data(), static_cast<size_t>(is.gcount())};
+    }
+};
+
+/// A file read with pread by a readahead thread that stays up to DEPTH - 1 chunks ahead of the
+/// consumer, so the disk and the parser work at the same time
+class FileStream : public InputStream
+{
+    static constexpr size_t DEPTH = 3;
+
+    int fd;
+    std::array<std::vector<char>, DEPTH> bufs;
+    std::array<size_t, DEPTH> lengths{};
+    // chunks read and chunks handed out; slot i % DEPTH holds chunk i
+    size_t produced{};
+    size_t consumed{};
+    bool holding = false;
+    bool stopping = false;
+    int error{};
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::thread reader;
+
+    void readAhead()
+    {
+        off_t offset{};
+        for (;;)
+        {
+            size_t slot{};
+            {
+                std::unique_lock lk{mutex};
+                cv.wait(lk, [this] { return stopping || produced - consumed < DEPTH; });
+                if (stopping)
+                {
+                    return;
+                }
+                slot = produced % DEPTH;
+            }
+            auto& buf = bufs[slot];
+            size_t filled{};
+            int err{};
+            while (filled < CHUNK)
+            {
+                auto n = ::pread(fd, std::next(buf.data(), static_cast<std::ptrdiff_t>(filled)),
+                                 CHUNK - filled, offset);
+                if (n < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (n < 0)
+                {
+                    err = errno;
+                    break;
+                }
+                if (n == 0)
+                {
+                    break;
+                }
+                filled += static_cast<size_t>(n);
+                offset += n;
+            }
+            {
+                std::lock_guard lk{mutex};
+                // a failed read ends the stream; next() reports it instead of a partial chunk
+                lengths[slot] = err != 0 ? 0 : filled;
+                error = err;
+                ++produced;
+            }
+            cv.notify_all();
+            if (filled == 0 || err != 0)
+            {
+                return;
+            }
+        }
+    }
+
+  public:
+    explicit FileStream(const std::filesystem::path& path)
+        : fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC)}
+    {
+        if (fd < 0)
+        {
+            throw std::system_error{errno, std::generic_category(), path.string()};
+        }
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        for (auto& buf : bufs)
+        {
+            buf.resize(CHUNK);
+        }
+        reader = std::thread{[this] { readAhead(); }};
+    }
+    FileStream(const FileStream&) = delete;
+    FileStream(FileStream&&) = delete;
+    FileStream& operator=(const FileStream&) = delete;
+    FileStream& operator=(FileStream&&) = delete;
+    ~FileStream() override
+    {
+        {
+            std::lock_guard lk{mutex};
+            stopping = true;
+        }
+        cv.notify_all();
+        reader.join();
+        ::close(fd);
+    }
+
+    std::string_view next() override
+    {
+        std::unique_lock lk{mutex};
+        if (holding)
+        {
+            // the previous chunk's slot can be refilled now
+            ++consumed;
+            holding = false;
+            cv.notify_all();
+        }
+        cv.wait(lk, [this] { return produced > consumed; });
+        auto slot = consumed % DEPTH;
+        if (lengths[slot] == 0)
+        {
+            if (error != 0)
+            {
+                throw std::system_error{error, std::generic_category(), "pread"};
+            }
+            return {};
+        }
+        holding = true;
+        return {bufs[slot].data(), lengths[slot]};
+    }
+};
+
+/// Feeds all of `input` to a default-constructed P, chunk by chunk, and returns it
+template <typename P> P parseStream(InputStream& input)
+{
+    P parser{};
+    for (auto chunk = input.next(); !chunk.empty(); chunk = input.next())
+    {
+        parser.feed(chunk);
+    }
+    if constexpr (requires { parser.finish(); })
+    {
+        parser.finish();
+    }
+    return parser;
+}
+
+template <size_t Y, size_t D> struct IsStreaming : std::false_type
+{
+};
+
+template <size_t Y, size_t D> Solution_t<Y, D> solve(InputStream& input);
+
+} // namespace aoc
@@ -0,0 +1,243 @@
+#pragma once
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fcntl.h>
+#include <optional>
+#include <poll.h>
+#include <string>
+#include <string_view>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <system_error>
+#include <unistd.h>
+#include <vector>
+
+/* Runs a piece of work in a forked child with a wall-clock budget, so a runaway solver costs one
+ * timeout instead of the whole run.  The child sends its result back over a pipe; the parent
+ * collects the exit status and peak RSS with wait4.
+ *
+ * The child only has the forking thread, so the work must not wait on pool threads that existed in
+ * the parent.  Callers keep solvers out of the parent process to make sure of that.  Nor may it
+ * take a lock another parent thread could have held at the fork (OpenSSL's, a parent-side mutex),
+ * so a caller forking from several threads keeps that kind of work out of the parallel phase.
+ */
+namespace aoc::isolate
+{
+
+enum class Status : uint8_t
+{
+    OK,
+    // the work threw; output holds the message
+    FAILED,
+    CRASHED,
+    TIMEOUT,
+};
+
+struct Result
+{
+    Status status = Status::OK;
+    std::string output;
+    // terminating signal when CRASHED
+    int signal{};
+    std::chrono::microseconds wall{};
+    // kilobytes, as reported by the kernel
+    long peakRssKb{};
+};
+
+namespace detail
+{
+// [ok byte][payload], ok = 1 when the work returned normally
+inline bool writeAll(int fd, std::string_view data)
+{
+    while (!data.empty())
+    {
+        auto n = ::write(fd, data.data(), data.size());
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        data.remove_prefix(static_cast<size_t>(n));
+    }
+    return true;
+}
+
+[[noreturn]] inline void runChild(int fd, const auto& work)
+{
+    // drop pipes other threads were setting up when we forked, so their EOFs aren't held open
+    if (fd > 3)
+    {
+        ::close_range(3, static_cast<unsigned>(fd) - 1, 0);
+    }
+    ::close_range(static_cast<unsigned>(fd) + 1, ~0U, 0);
+    std::string message;
+    char ok = 1;
+    try
+    {
+        message = work();
+    }
+    catch (const std::exception& e)
+    {
+        ok = 0;
+        message = e.what();
+    }
+    catch (...)
+    {
+        ok = 0;
+        message = "unknown exception";
+    }
+    bool sent = writeAll(fd, std::string_view{&ok, 1}) && writeAll(fd, message);
+    // skip static destructors and atexit handlers, they belong to the parent
+    ::_exit(sent ? 0 : 1);
+}
+} // namespace detail
+
+/// Runs `work` (returning std::string) in a child process, killing it after `timeout` if given
+template <typename F> Result run(F&& work, std::optional<std::chrono::milliseconds> timeout)
+{
+    using Clock = std::chrono::steady_clock;
+    std::array<int, 2> fds{};
+    if (::pipe2(fds.data(), O_CLOEXEC) != 0)
+    {
+        throw std::system_error{errno, std::generic_category(), "pipe2"};
+    }
+    auto start = Clock::now();
+    pid_t pid = ::fork();
+    if (pid < 0)
+    {
+        auto err = errno;
+        ::close(fds[0]);
+        ::close(fds[1]);
+        throw std::system_error{err, std::generic_category(), "fork"};
+    }
+    if (pid == 0)
+    {
+        ::close(fds[0]);
+        detail::runChild(fds[1], work);
+    }
+    ::close(fds[1]);
+
+    Result result;
+    std::string received;
+    bool timedOut = false;
+    std::array<char, 4096> buf{}; // NOLINT(*-magic-numbers)
+    for (;;)
+    {
+        int waitMs = -1;
+        if (timeout)
+        {
+            auto left = *timeout - std::chrono::duration_cast<std::chrono::milliseconds>(
+                                       Clock::now() - start);
+            if (left.count() <= 0)
+            {
+                timedOut = true;
+                break;
+            }
+            waitMs = static_cast<int>(left.count());
+        }
+        pollfd pfd{fds[0], POLLIN, 0};
+        auto ready = ::poll(&pfd, 1, waitMs);
+        if (ready < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (ready == 0)
+        {
+            continue;
+        }
+        auto n = ::read(fds[0], buf.data(), buf.size());
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            break;
+        }
+        received.append(buf.data(), static_cast<size_t>(n));
+    }
+    ::close(fds[0]);
+    if (timedOut)
+    {
+        ::kill(pid, SIGKILL);
+    }
+
+    int status{};
+    rusage usage{};
+    while (::wait4(pid, &status, 0, &usage) < 0 && errno == EINTR)
+    {
+    }
+    result.wall = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+    result.peakRssKb = usage.ru_maxrss;
+
+    if (timedOut)
+    {
+        result.status = Status::TIMEOUT;
+    }
+    else if (WIFSIGNALED(status))
+    {
+        result.status = Status::CRASHED;
+        result.signal = WTERMSIG(status);
+    }
+    else if (received.empty() || WEXITSTATUS(status) != 0)
+    {
+        result.status = Status::CRASHED;
+    }
+    else
+    {
+        result.status = received[0] == 1 ? Status::OK : Status::FAILED;
+        result.output = received.substr(1);
+    }
+    return result;
+}
+
+/// '\0'-separated fields, for passing a few strings back from the child
+inline std::string pack(const std::vector<std::string>& fields)
+{
+    std::string out;
+    for (const auto& f : fields)
+    {
+        out += f;
+        out += '\0';
+    }
+    return out;
+}
+
+inline std::vector<std::string> unpack(std::string_view packed)
+{
+    std::vector<std::string> fields;
+    for (size_t pos = 0; pos < packed.size();)
+    {
+        auto end = packed.find('\0', pos);
+        if (end == std::string_view::npos)
+        {
+            end = packed.size();
+        }
+        fields.emplace_back(packed.substr(pos, end - pos));
+        pos = end + 1;
+    }
+    return fields;
+}
+
+inline std::string describe(const Result& r)
+{
+    switch (r.status)
+    {
+    case Status::OK: return "ok";
+    case Status::FAILED: return "threw: " + r.output;
+    case Status::TIMEOUT: return "timed out";
+    case Status::CRASHED:
+        return r.signal != 0 ? std::string{"killed by "} + ::strsignal(r.signal) : "crashed";
+    }
+    return {};
+}
+
+} // namespace aoc::isolate
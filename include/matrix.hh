@@ -1,6 +1,8 @@
 #pragma once
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 
 template <typename T = float> struct Matrix
 {
@@ -15,6 +17,16 @@ template <typename T = float> struct Matrix
     size_t rows_, cols_;
     std::vector<T> data;
 
+    // what fraction-free elimination leaves besides the matrix: the value every pivot ended up
+    // as, how many pivots there are and whether an odd number of row swaps happened
+    struct Elimination
+    {
+        T pivot;
+        size_t rank;
+        bool oddSwaps;
+    };
+    Elimination bareiss();
+
   public:
     Matrix(size_t r, size_t c) : rows_(r), cols_(c), data(r * c, 0) {}
 
@@ -92,6 +104,15 @@ template <typename T = float> struct Matrix
 
     Matrix& rowReduce();
 
+    /// Fraction-free Gauss-Jordan (Bareiss) for integer T.  Every division is exact, so entries
+    /// stay integers without taking any gcds; each is a minor of the original matrix, so they
+    /// grow no faster than determinants do.  Leaves reduced row echelon form except that every
+    /// pivot is the returned value instead of 1.
+    T bareissReduce();
+
+    /// Determinant of a square integer matrix, by the same elimination on a copy
+    T determinant() const;
+
     struct ColumnIterator
     {
         using iterator_category = std::random_access_iterator_tag;
@@ -297,4 +318,66 @@ template <typename T> Matrix<T>& Matrix<T>::rowReduce()
         lead++;
     }
     return *this;
-}
\ No newline at end of file
+}
+
+template <typename T> typename Matrix<T>::Elimination Matrix<T>::bareiss()
+{
+    static_assert(std::numeric_limits<T>::is_integer, "bareiss needs exact integer division");
+    Elimination e{1, 0, false};
+    for (size_t lead = 0; lead < cols_ && e.rank < rows_; lead++)
+    {
+        size_t r = e.rank;
+        size_t i = r;
+        while (i < rows_ && data[i * cols_ + lead] == 0)
+        {
+            i++;
+        }
+        if (i == rows_)
+        {
+            continue;
+        }
+        if (i != r)
+        {
+            swapRows(i, r);
+            e.oddSwaps = !e.oddSwaps;
+        }
+        T p = data[r * cols_ + lead];
+        // every 2x2 minor through the pivot, divided by the previous pivot (Sylvester's identity
+        // makes that exact).  Rows above are included, which brings their pivots up to p as well
+        for (size_t other = 0; other < rows_; other++)
+        {
+            if (other == r)
+            {
+                continue;
+            }
+            T f = data[other * cols_ + lead];
+            for (size_t c = 0; c < cols_; c++)
+            {
+                auto& v = data[other * cols_ + c];
+                v = (p * v - f * data[r * cols_ + c]) / e.pivot;
+            }
+        }
+        e.pivot = p;
+        e.rank++;
+    }
+    return e;
+}
+
+template <typename T> T Matrix<T>::bareissReduce()
+{
+    return bareiss().pivot;
+}
+
+template <typename T> T Matrix<T>::determinant() const
+{
+    if (rows_ != cols_)
+    {
+        throw std::invalid_argument("Determinant of a non-square matrix");
+    }
+    auto e = Matrix{*this}.bareiss();
+    if (e.rank < rows_)
+    {
+        return 0;
+    }
+    return e.oddSwaps ? -e.pivot : e.pivot;
+}
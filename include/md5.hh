@@ -0,0 +1,391 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/* MD5 without OpenSSL, for the days that hash millions of short messages.  The compression
+ * function is written once over a word type W: plain uint32_t for one message, or a GCC vector of
+ * LANES words that hashes LANES independent messages at once, one per vector lane.  LANES follows
+ * the widest vector unit the build targets (16 with AVX-512, 8 with AVX2, otherwise 4), so
+ * configure with AOC_NATIVE to get the wide ones.
+ *
+ * Digests are written into caller-owned fixed-size arrays; nothing here allocates.
+ */
+namespace Hash::md5
+{
+
+using Digest = std::array<uint8_t, 16>;
+// one 64-byte block as little-endian words
+using Block = std::array<uint32_t, 16>;
+
+#if defined(__AVX512F__)
+inline constexpr size_t LANES = 16;
+#elif defined(__AVX2__)
+inline constexpr size_t LANES = 8;
+#else
+inline constexpr size_t LANES = 4;
+#endif
+
+// NOLINTNEXTLINE(*-magic-numbers)
+using Lanes = uint32_t __attribute__((vector_size(LANES * sizeof(uint32_t))));
+
+inline constexpr size_t BLOCK_BYTES = 64;
+// message bytes that still fit in the final block beside the 0x80 marker and the bit length
+inline constexpr size_t MAX_TAIL = BLOCK_BYTES - 9;
+
+namespace detail
+{
+// NOLINTBEGIN(*-magic-numbers)
+inline constexpr std::array<uint32_t, 4> INIT = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+
+inline constexpr std::array<uint32_t, 64> K = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+
+inline constexpr std::array<unsigned, 16> SHIFTS = {7, 12, 17, 22, 5, 9,  14, 20,
+                                                    4, 11, 16, 23, 6, 10, 15, 21};
+
+template <size_t I> constexpr size_t messageIndex()
+{
+    switch (I / 16)
+    {
+    case 0: return I;
+    case 1: return (5 * I + 1) % 16;
+    case 2: return (3 * I + 5) % 16;
+    default: return (7 * I) % 16;
+    }
+}
+
+template <unsigned S, typename W> W rotl(W x)
+{
+    return (x << S) | (x >> (32 - S));
+}
+
+template <size_t I, typename W> void step(std::array<W, 4>& v, const std::array<W, 16>& m)
+{
+    auto& [a, b, c, d] = v;
+    W f;
+    if constexpr (I < 16)
+    {
+        f = (b & c) | (~b & d);
+    }
+    else if constexpr (I < 32)
+    {
+        f = (d & b) | (~d & c);
+    }
+    else if constexpr (I < 48)
+    {
+        f = b ^ c ^ d;
+    }
+    else
+    {
+        f = c ^ (b | ~d);
+    }
+    f = f + a + K[I] + m[messageIndex<I>()];
+    a = d;
+    d = c;
+    c = b;
+    b = b + rotl<SHIFTS[(I / 16) * 4 + I % 4]>(f);
+}
+// NOLINTEND(*-magic-numbers)
+
+inline uint32_t loadWord(const uint8_t* p)
+{
+    uint32_t w{};
+    std::memcpy(&w, p, sizeof(w));
+    if constexpr (std::endian::native == std::endian::big)
+    {
+        w = std::byteswap(w);
+    }
+    return w;
+}
+} // namespace detail
+
+/// The running hash of one message (W = uint32_t) or LANES of them (W = Lanes)
+template <typename W> struct State
+{
+    std::array<W, 4> h = {W{} + detail::INIT[0], W{} + detail::INIT[1], W{} + detail::INIT[2],
+                          W{} + detail::INIT[3]};
+
+    void compress(const std::array<W, 16>& m)
+    {
+        constexpr size_t STEPS = 64;
+        auto v = h;
+        [&]<size_t... I>(std::index_sequence<I...> /*unused*/)
+        { (detail::step<I>(v, m), ...); }(std::make_index_sequence<STEPS>{});
+        for (size_t i = 0; i < 4; ++i)
+        {
+            h[i] += v[i];
+        }
+    }
+};
+
+/// Number of blocks a message of `size` bytes pads out to
+constexpr size_t blockCount(size_t size)
+{
+    return (size + 8) / BLOCK_BYTES + 1;
+}
+
+/// Block `index` of `message` after padding
+inline Block paddedBlock(std::string_view message, size_t index)
+{
+    std::array<uint8_t, BLOCK_BYTES> bytes{};
+    auto offset = index * BLOCK_BYTES;
+    if (offset < message.size())
+    {
+        auto n = std::min(BLOCK_BYTES, message.size() - offset);
+        std::memcpy(bytes.data(), std::next(message.data(), static_cast<std::ptrdiff_t>(offset)),
+                    n);
+    }
+    if (message.size() >= offset && message.size() < offset + BLOCK_BYTES)
+    {
+        bytes[message.size() - offset] = 0x80; // NOLINT(*-magic-numbers)
+    }
+    if (index + 1 == blockCount(message.size()))
+    {
+        uint64_t bits = uint64_t{message.size()} * 8;
+        for (size_t i = 0; i < 8; ++i) // NOLINT(*-magic-numbers)
+        {
+            bytes[MAX_TAIL + 1 + i] = static_cast<uint8_t>(bits >> (8 * i)); // NOLINT
+        }
+    }
+    Block block;
+    for (size_t i = 0; i < block.size(); ++i)
+    {
+        block[i] = detail::loadWord(&bytes[4 * i]);
+    }
+    return block;
+}
+
+/// Little-endian bytes of a finished state
+inline void store(const std::array<uint32_t, 4>& h, Digest& out)
+{
+    for (size_t i = 0; i < 4; ++i)
+    {
+        for (size_t b = 0; b < 4; ++b)
+        {
+            out[4 * i + b] = static_cast<uint8_t>(h[i] >> (8 * b)); // NOLINT(*-magic-numbers)
+        }
+    }
+}
+
+/// Digest of one lane of a multi-lane state
+inline void store(const State<Lanes>& s, size_t lane, Digest& out)
+{
+    store({s.h[0][lane], s.h[1][lane], s.h[2][lane], s.h[3][lane]}, out);
+}
+
+inline void digest(std::string_view message, Digest& out)
+{
+    State<uint32_t> s;
+    for (size_t b = 0; b < blockCount(message.size()); ++b)
+    {
+        s.compress(paddedBlock(message, b));
+    }
+    store(s.h, out);
+}
+
+inline Digest digest(std::string_view message)
+{
+    Digest out;
+    digest(message, out);
+    return out;
+}
+
+/// Hashes messages[i] into out[i], LANES messages at a time.  Fastest when the messages in a
+/// group are the same number of blocks, as the group runs for as many blocks as its longest.
+inline void digest(std::span<const std::string_view> messages, std::span<Digest> out)
+{
+    for (size_t base = 0; base < messages.size(); base += LANES)
+    {
+        auto count = std::min(LANES, messages.size() - base);
+        auto group = messages.subspan(base, count);
+        size_t blocks{};
+        for (auto m : group)
+        {
+            blocks = std::max(blocks, blockCount(m.size()));
+        }
+        State<Lanes> s;
+        for (size_t b = 0; b < blocks; ++b)
+        {
+            std::array<Lanes, 16> m{};
+            Lanes active{};
+            for (size_t lane = 0; lane < count; ++lane)
+            {
+                if (b >= blockCount(group[lane].size()))
+                {
+                    continue;
+                }
+                active[lane] = ~uint32_t{};
+                auto block = paddedBlock(group[lane], b);
+                for (size_t w = 0; w < block.size(); ++w)
+                {
+                    m[w][lane] = block[w];
+                }
+            }
+            auto before = s.h;
+            s.compress(m);
+            // lanes whose message already ended keep their state
+            for (size_t i = 0; i < 4; ++i)
+            {
+                s.h[i] = (s.h[i] & active) | (before[i] & ~active);
+            }
+        }
+        for (size_t lane = 0; lane < count; ++lane)
+        {
+            store(s, lane, out[base + lane]);
+        }
+    }
+}
+
+/// Mask over the first state word covering the first `nibbles` hex digits of the digest (up to 8):
+/// the digest starts with that many zeros exactly when h[0] & mask is 0
+constexpr uint32_t leadingNibbleMask(int nibbles)
+{
+    uint32_t mask{};
+    for (int i = 0; i < nibbles; ++i)
+    {
+        // digest byte i / 2 is the i / 2'th byte of h[0], high nibble first
+        auto shift = 8 * (i / 2) + (i % 2 == 0 ? 4 : 0); // NOLINT(*-magic-numbers)
+        mask |= uint32_t{0xF} << shift;                   // NOLINT(*-magic-numbers)
+    }
+    return mask;
+}
+
+/// Lanes of `word` with no bits of `mask` set, as a bit per lane
+inline uint32_t zeroLanes(const Lanes& word, uint32_t mask)
+{
+    uint32_t bits{};
+    auto zero = (word & mask) == 0;
+    for (size_t lane = 0; lane < LANES; ++lane)
+    {
+        bits |= static_cast<uint32_t>(zero[lane] != 0) << lane;
+    }
+    return bits;
+}
+
+/* MD5 of prefix + n in decimal for n = start, start + 1, ..., LANES values per call.  The prefix's
+ * whole blocks are hashed once up front; the counter is kept as ASCII inside the preformatted final
+ * block and incremented there, so each candidate costs one compression and a few word copies.
+ * The part of the prefix past its last whole block plus the counter must fit in MAX_TAIL bytes.
+ */
+class CounterHasher
+{
+    State<Lanes> midstate;
+    std::array<uint8_t, BLOCK_BYTES> tail{};
+    size_t prefixSize;
+    // where the counter's digits start in `tail`
+    size_t digitsAt;
+    size_t digits{};
+    uint64_t counter;
+    std::array<Lanes, 16> words{};
+    // lanes still to copy in full after the counter gained a digit and moved the padding
+    size_t fullCopies{};
+
+    void layout()
+    {
+        if (digitsAt + digits > MAX_TAIL)
+        {
+            throw std::length_error{"md5::CounterHasher: prefix tail and counter exceed a block"};
+        }
+        std::fill(std::next(tail.begin(), static_cast<std::ptrdiff_t>(digitsAt + digits)),
+                  tail.end(), uint8_t{});
+        tail[digitsAt + digits] = 0x80; // NOLINT(*-magic-numbers)
+        uint64_t bits = uint64_t{prefixSize + digits} * 8;
+        for (size_t i = 0; i < 8; ++i) // NOLINT(*-magic-numbers)
+        {
+            tail[MAX_TAIL + 1 + i] = static_cast<uint8_t>(bits >> (8 * i)); // NOLINT
+        }
+    }
+
+    // true when the counter gained a digit
+    bool increment()
+    {
+        ++counter;
+        for (auto i = digitsAt + digits; i-- > digitsAt;)
+        {
+            if (tail[i] != '9')
+            {
+                ++tail[i];
+                return false;
+            }
+            tail[i] = '0';
+        }
+        tail[digitsAt] = '1';
+        tail[digitsAt + digits] = '0';
+        ++digits;
+        layout();
+        return true;
+    }
+
+  public:
+    CounterHasher(std::string_view prefix, uint64_t start)
+        : prefixSize{prefix.size()}, digitsAt{prefix.size() % BLOCK_BYTES}, counter{start}
+    {
+        auto whole = prefix.size() - digitsAt;
+        for (size_t b = 0; b < whole / BLOCK_BYTES; ++b)
+        {
+            auto block = paddedBlock(prefix, b);
+            std::array<Lanes, 16> m;
+            for (size_t w = 0; w < m.size(); ++w)
+            {
+                m[w] = Lanes{} + block[w];
+            }
+            midstate.compress(m);
+        }
+        std::memcpy(tail.data(), std::next(prefix.data(), static_cast<std::ptrdiff_t>(whole)),
+                    digitsAt);
+        auto text = std::to_string(start);
+        digits = text.size();
+        std::memcpy(std::next(tail.data(), static_cast<std::ptrdiff_t>(digitsAt)), text.data(),
+                    digits);
+        layout();
+        for (size_t w = 0; w < words.size(); ++w)
+        {
+            words[w] = Lanes{} + detail::loadWord(&tail[4 * w]);
+        }
+    }
+
+    /// The counter the next call starts from
+    [[nodiscard]] uint64_t next() const
+    {
+        return counter;
+    }
+
+    /// Hashes counters next() .. next() + LANES - 1 into the lanes of `out`, in order
+    void hash(State<Lanes>& out)
+    {
+        for (size_t lane = 0; lane < LANES; ++lane)
+        {
+            auto first = digitsAt / 4;
+            auto last = fullCopies > 0 ? words.size() - 1 : (digitsAt + digits) / 4;
+            fullCopies -= fullCopies > 0 ? 1 : 0;
+            for (auto w = first; w <= last; ++w)
+            {
+                words[w][lane] = detail::loadWord(&tail[4 * w]);
+            }
+            if (increment())
+            {
+                fullCopies = 2 * LANES;
+            }
+        }
+        out = midstate;
+        out.compress(words);
+    }
+};
+
+} // namespace Hash::md5
@@ -0,0 +1,187 @@
+#pragma once
+#include "md5.hh"
+#include "threadpool.hh"
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/* Parallel search over consecutive indices whose results must still be consumed in order, as the
+ * MD5 miners of 2015 day 4 and 2016 day 5 and the key stream of 2016 day 14 need.  The indices are
+ * cut into chunks that the shared pool's workers claim in turn; each chunk's results are parked
+ * until every chunk before it is done, so the caller sees them in order no matter which thread
+ * produced them.
+ *
+ * The calling thread produces chunks too while it waits for the next one in order, so the search
+ * makes progress even when every pool worker is busy elsewhere (or the caller is one of them).
+ */
+namespace aoc::mining
+{
+
+struct Hit
+{
+    uint64_t index;
+    Hash::md5::Digest digest;
+};
+
+namespace detail
+{
+inline constexpr uint64_t CHUNK = Hash::md5::LANES * 4096;
+
+inline std::vector<Hit> mineChunk(std::string_view prefix, uint32_t mask, uint64_t chunk)
+{
+    std::vector<Hit> hits;
+    Hash::md5::CounterHasher hasher{prefix, chunk * CHUNK};
+    Hash::md5::State<Hash::md5::Lanes> state;
+    for (uint64_t base = chunk * CHUNK; base < (chunk + 1) * CHUNK; base += Hash::md5::LANES)
+    {
+        hasher.hash(state);
+        for (auto lanes = Hash::md5::zeroLanes(state.h[0], mask); lanes != 0; lanes &= lanes - 1)
+        {
+            auto lane = static_cast<size_t>(std::countr_zero(lanes));
+            auto& hit = hits.emplace_back(base + lane);
+            Hash::md5::store(state, lane, hit.digest);
+        }
+    }
+    return hits;
+}
+} // namespace detail
+
+/// Runs produce(chunk) for chunk = 0, 1, ... on the shared pool and hands every element of the
+/// results to accept, in chunk order, until it returns false.  Workers run at most `lookahead`
+/// chunks ahead of the caller; finished chunks wait in a ring of that many slots.
+template <typename Produce, typename Accept>
+void orderedChunks(Produce&& produce, Accept&& accept, size_t lookahead = 0)
+{
+    using Result = std::invoke_result_t<Produce&, uint64_t>;
+    struct Slot
+    {
+        Result value;
+        std::atomic<bool> ready{false};
+    };
+
+    auto workers = ThreadPool::shared().size();
+    if (lookahead == 0)
+    {
+        lookahead = 2 * (workers + 1);
+    }
+    auto ring = std::make_unique<Slot[]>(lookahead); // NOLINT(*-avoid-c-arrays)
+    std::atomic<uint64_t> nextChunk{};
+    std::atomic<uint64_t> wanted{};
+    std::atomic<size_t> active{};
+    std::atomic<bool> stop{false};
+    std::atomic<bool> failed{false};
+
+    // the next chunk to produce, unless its slot is still waiting for the caller
+    auto claim = [&]() -> std::optional<uint64_t>
+    {
+        auto c = nextChunk.load();
+        do
+        {
+            if (c >= wanted.load(std::memory_order_acquire) + lookahead)
+            {
+                return {};
+            }
+        } while (!nextChunk.compare_exchange_weak(c, c + 1));
+        return c;
+    };
+    auto work = [&](uint64_t chunk)
+    {
+        auto& slot = ring[chunk % lookahead];
+        slot.value = produce(chunk);
+        slot.ready.store(true, std::memory_order_release);
+    };
+
+    TaskGroup group;
+    // workers leave once they're a full ring ahead, the caller tops them up as it catches up
+    auto spawn = [&]
+    {
+        while (active.load() < workers && !stop.load())
+        {
+            ++active;
+            group.run(
+                [&]
+                {
+                    try
+                    {
+                        while (!stop.load(std::memory_order_relaxed))
+                        {
+                            auto chunk = claim();
+                            if (!chunk)
+                            {
+                                break;
+                            }
+                            work(*chunk);
+                        }
+                    }
+                    catch (...)
+                    {
+                        failed = true;
+                        --active;
+                        throw;
+                    }
+                    --active;
+                });
+        }
+    };
+
+    try
+    {
+        for (uint64_t want = 0;; ++want)
+        {
+            spawn();
+            auto& slot = ring[want % lookahead];
+            // help rather than wait, so this works even with every pool worker busy elsewhere
+            while (!slot.ready.load(std::memory_order_acquire))
+            {
+                if (failed)
+                {
+                    stop = true;
+                    group.wait();
+                }
+                if (auto chunk = claim())
+                {
+                    work(*chunk);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+            auto value = std::move(slot.value);
+            slot.ready.store(false, std::memory_order_relaxed);
+            wanted.store(want + 1, std::memory_order_release);
+            for (const auto& item : value)
+            {
+                if (!accept(item))
+                {
+                    stop = true;
+                    group.wait();
+                    return;
+                }
+            }
+        }
+    }
+    catch (...)
+    {
+        stop = true;
+        throw;
+    }
+}
+
+/// Calls accept(const Hit&) for every n = 0, 1, ... whose MD5(prefix + n) starts with `zeros` zero
+/// hex digits (at most 8), in increasing order of n, until it returns false
+template <typename F> void mine(std::string_view prefix, int zeros, F&& accept)
+{
+    auto mask = Hash::md5::leadingNibbleMask(zeros);
+    orderedChunks([prefix, mask](uint64_t chunk) { return detail::mineChunk(prefix, mask, chunk); },
+                  std::forward<F>(accept));
+}
+
+} // namespace aoc::mining
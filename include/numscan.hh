@@ -0,0 +1,145 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace aoc
+{
+
+template <typename T>
+concept ScannableInt =
+    std::integral<T> && !std::same_as<T, bool> && !std::same_as<std::remove_cv_t<T>, char>;
+
+namespace detail
+{
+// Bitmask of the digit bytes in a block of SCAN_WIDTH bytes.  Unsigned saturating subtract-and-
+// compare does the range check in two instructions; the SSE4.2 string instructions can express
+// the same range but have far higher latency than compare + movemask.
+#if defined(__AVX2__)
+constexpr size_t SCAN_WIDTH = 32;
+inline uint32_t digitMask(const char* p)
+{
+    auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); // NOLINT
+    auto off = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+    auto inRange = _mm256_cmpeq_epi8(_mm256_min_epu8(off, _mm256_set1_epi8(9)), off);
+    return static_cast<uint32_t>(_mm256_movemask_epi8(inRange));
+}
+#elif defined(__SSE2__)
+constexpr size_t SCAN_WIDTH = 16;
+inline uint32_t digitMask(const char* p)
+{
+    auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); // NOLINT
+    auto off = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+    auto inRange = _mm_cmpeq_epi8(_mm_min_epu8(off, _mm_set1_epi8(9)), off);
+    return static_cast<uint32_t>(_mm_movemask_epi8(inRange));
+}
+#endif
+
+constexpr bool isDigit(char c)
+{
+    return static_cast<unsigned char>(c - '0') < 10; // NOLINT(*-magic-numbers)
+}
+} // namespace detail
+
+/// Extracts the integers (digit runs, negative when directly preceded by '-') from a buffer,
+/// filling caller-provided storage a block at a time.  Matches the `-?\d+` search readNumbers has
+/// always done; an unsigned T ignores the sign.  Values that overflow T wrap.
+class NumberScanner
+{
+    std::string_view text;
+    size_t pos{};
+
+    // index of the first digit at or after `from`, or text.size()
+    [[nodiscard]] size_t nextDigit(size_t from) const
+    {
+#if defined(__AVX2__) || defined(__SSE2__)
+        for (; from + detail::SCAN_WIDTH <= text.size(); from += detail::SCAN_WIDTH)
+        {
+            if (auto m = detail::digitMask(std::next(text.data(), from)); m != 0)
+            {
+                return from + static_cast<size_t>(std::countr_zero(m));
+            }
+        }
+#endif
+        for (; from < text.size(); ++from)
+        {
+            if (detail::isDigit(text[from]))
+            {
+                return from;
+            }
+        }
+        return text.size();
+    }
+
+  public:
+    explicit NumberScanner(std::string_view text) : text{text} {}
+
+    [[nodiscard]] bool done() const
+    {
+        return pos >= text.size();
+    }
+
+    /// Writes up to out.size() numbers, returns how many were written; 0 once the text is used up
+    template <ScannableInt T> size_t next(std::span<T> out)
+    {
+        using U = std::make_unsigned_t<T>;
+        constexpr U BASE = 10;
+        size_t n = 0;
+        while (n < out.size())
+        {
+            auto start = nextDigit(pos);
+            if (start == text.size())
+            {
+                pos = start;
+                break;
+            }
+            U value{};
+            for (pos = start; pos < text.size() && detail::isDigit(text[pos]); ++pos)
+            {
+                value = value * BASE + static_cast<U>(text[pos] - '0');
+            }
+            if constexpr (std::is_signed_v<T>)
+            {
+                if (start > 0 && text[start - 1] == '-')
+                {
+                    value = U{} - value;
+                }
+            }
+            out[n++] = static_cast<T>(value);
+        }
+        return n;
+    }
+};
+
+/// Fills `out` with the first numbers in `text`, returns how many were found
+template <ScannableInt T> size_t scanNumbers(std::string_view text, std::span<T> out)
+{
+    return NumberScanner{text}.next(out);
+}
+
+/// Appends every number in `text` to `out`
+template <ScannableInt T, typename A>
+void scanNumbers(std::string_view text, std::vector<T, A>& out)
+{
+    constexpr size_t BLOCK = 256;
+    NumberScanner scanner{text};
+    std::array<T, BLOCK> block{};
+    while (auto n = scanner.next<T>(block))
+    {
+        out.insert(out.end(), block.begin(),
+                   std::next(block.begin(), static_cast<std::ptrdiff_t>(n)));
+    }
+}
+
+} // namespace aoc
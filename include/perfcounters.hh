@@ -0,0 +1,209 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/* Hardware performance counters around a region of code, via perf_event_open.  Each event is opened
+ * on its own so that a PMU lacking one event (or a VM exposing none) still yields the rest; in a
+ * container without perf access every value simply comes back empty.  Counters follow threads
+ * created inside the region (inherit), so solvers that spawn their own workers are fully counted.
+ */
+namespace aoc::perf
+{
+
+enum Event : uint8_t
+{
+    CYCLES,
+    INSTRUCTIONS,
+    BRANCHES,
+    BRANCH_MISSES,
+    L1D_LOADS,
+    L1D_LOAD_MISSES,
+    LLC_REFERENCES,
+    LLC_MISSES,
+    EVENT_COUNT
+};
+
+constexpr std::array<std::string_view, EVENT_COUNT> EVENT_NAMES = {
+    "cycles",    "instructions",    "branches",       "branch_misses",
+    "l1d_loads", "l1d_load_misses", "llc_references", "llc_misses"};
+
+struct Sample
+{
+    std::array<std::optional<double>, EVENT_COUNT> values{};
+
+    [[nodiscard]] std::optional<double> ratio(Event num, Event den) const
+    {
+        if (!values[num] || !values[den] || *values[den] == 0)
+        {
+            return {};
+        }
+        return *values[num] / *values[den];
+    }
+    [[nodiscard]] std::optional<double> ipc() const
+    {
+        return ratio(INSTRUCTIONS, CYCLES);
+    }
+    [[nodiscard]] std::optional<double> branchMissRate() const
+    {
+        return ratio(BRANCH_MISSES, BRANCHES);
+    }
+    [[nodiscard]] std::optional<double> l1dMissRate() const
+    {
+        return ratio(L1D_LOAD_MISSES, L1D_LOADS);
+    }
+    [[nodiscard]] std::optional<double> llcMissRate() const
+    {
+        return ratio(LLC_MISSES, LLC_REFERENCES);
+    }
+};
+
+class Counters
+{
+    std::array<int, EVENT_COUNT> fds{};
+    int openError{};
+
+#ifdef __linux__
+    static perf_event_attr attrFor(Event e)
+    {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        constexpr auto CACHE_OP_SHIFT = 8U;
+        constexpr auto CACHE_RESULT_SHIFT = 16U;
+        auto cache = [](uint64_t id, uint64_t result)
+        {
+            return id | (PERF_COUNT_HW_CACHE_OP_READ << CACHE_OP_SHIFT) |
+                   (result << CACHE_RESULT_SHIFT);
+        };
+        attr.type = PERF_TYPE_HARDWARE;
+        switch (e)
+        {
+        case CYCLES: attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+        case INSTRUCTIONS: attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+        case BRANCHES: attr.config = PERF_COUNT_HW_BRANCH_INSTRUCTIONS; break;
+        case BRANCH_MISSES: attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+        case LLC_REFERENCES: attr.config = PERF_COUNT_HW_CACHE_REFERENCES; break;
+        case LLC_MISSES: attr.config = PERF_COUNT_HW_CACHE_MISSES; break;
+        case L1D_LOADS:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = cache(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_RESULT_ACCESS);
+            break;
+        case L1D_LOAD_MISSES:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = cache(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_RESULT_MISS);
+            break;
+        default: break;
+        }
+        return attr;
+    }
+#endif
+
+  public:
+    Counters()
+    {
+        fds.fill(-1);
+#ifdef __linux__
+        for (size_t e = 0; e < EVENT_COUNT; ++e)
+        {
+            auto attr = attrFor(static_cast<Event>(e));
+            // this process, any cpu, no group
+            fds[e] = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fds[e] < 0 && openError == 0)
+            {
+                openError = errno;
+            }
+        }
+#else
+        openError = ENOSYS;
+#endif
+    }
+    Counters(const Counters&) = delete;
+    Counters(Counters&&) = delete;
+    Counters& operator=(const Counters&) = delete;
+    Counters& operator=(Counters&&) = delete;
+    ~Counters()
+    {
+#ifdef __linux__
+        for (auto fd : fds)
+        {
+            if (fd >= 0)
+            {
+                ::close(fd);
+            }
+        }
+#endif
+    }
+
+    [[nodiscard]] bool available() const
+    {
+        return std::ranges::any_of(fds, [](int fd) { return fd >= 0; });
+    }
+
+    // why the first event that failed to open didn't, empty when all opened
+    [[nodiscard]] std::string unavailableReason() const
+    {
+        return openError == 0 ? std::string{} : std::strerror(openError);
+    }
+
+    void start()
+    {
+#ifdef __linux__
+        for (auto fd : fds)
+        {
+            if (fd >= 0)
+            {
+                ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    Sample stop()
+    {
+        Sample s;
+#ifdef __linux__
+        for (auto fd : fds)
+        {
+            if (fd >= 0)
+            {
+                ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+        for (size_t e = 0; e < EVENT_COUNT; ++e)
+        {
+            // value, time enabled, time running
+            std::array<uint64_t, 3> buf{};
+            if (fds[e] < 0 || ::read(fds[e], buf.data(), sizeof(buf)) != sizeof(buf) ||
+                buf[2] == 0)
+            {
+                continue;
+            }
+            // scale up if the kernel had to multiplex this event with others
+            s.values[e] = static_cast<double>(buf[0]) * static_cast<double>(buf[1]) /
+                          static_cast<double>(buf[2]);
+        }
+#endif
+        return s;
+    }
+};
+
+} // namespace aoc::perf
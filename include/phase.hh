@@ -0,0 +1,107 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* Scoped phase timers for use inside solvers:
+ *
+ *     { AOC_PHASE("parse"); ... }
+ *
+ * Phases nest, and are only recorded on a thread with an active phase::Recorder (the benchmark
+ * harness installs one around each solve).  Without AOC_PHASES defined the macro expands to nothing;
+ * CMake defines it outside Release builds, or everywhere with -DAOC_PHASES=ON.
+ */
+namespace aoc::phase
+{
+
+using Clock = std::chrono::steady_clock;
+
+struct Record
+{
+    // slash-separated names of the enclosing phases, e.g. "part1/build"
+    std::string path;
+    size_t depth{};
+    Clock::time_point start;
+    Clock::duration duration{};
+};
+
+class Recorder
+{
+    std::vector<Record> records_;
+    std::vector<size_t> open;
+    Recorder* previous;
+
+    static inline thread_local Recorder* active{};
+
+    friend class Scope;
+
+  public:
+    Recorder() : previous{std::exchange(active, this)} {}
+    Recorder(const Recorder&) = delete;
+    Recorder(Recorder&&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+    Recorder& operator=(Recorder&&) = delete;
+    ~Recorder()
+    {
+        active = previous;
+    }
+
+    [[nodiscard]] const std::vector<Record>& records() const
+    {
+        return records_;
+    }
+
+    // hands back everything recorded so far and starts afresh; only call between solves
+    std::vector<Record> take()
+    {
+        open.clear();
+        return std::exchange(records_, {});
+    }
+};
+
+class Scope
+{
+    Recorder* recorder;
+    size_t index{};
+
+  public:
+    explicit Scope(const char* name) : recorder{Recorder::active}
+    {
+        if (recorder == nullptr)
+        {
+            return;
+        }
+        auto& recs = recorder->records_;
+        std::string path =
+            recorder->open.empty() ? name : recs[recorder->open.back()].path + "/" + name;
+        index = recs.size();
+        recs.push_back({std::move(path), recorder->open.size(), Clock::now(), {}});
+        recorder->open.push_back(index);
+    }
+    Scope(const Scope&) = delete;
+    Scope(Scope&&) = delete;
+    Scope& operator=(const Scope&) = delete;
+    Scope& operator=(Scope&&) = delete;
+    ~Scope()
+    {
+        if (recorder == nullptr || recorder->open.empty())
+        {
+            return;
+        }
+        auto& rec = recorder->records_[index];
+        rec.duration = Clock::now() - rec.start;
+        recorder->open.pop_back();
+    }
+};
+
+} // namespace aoc::phase
+
+#define AOC_PHASE_CONCAT_(a, b) a##b
+#define AOC_PHASE_CONCAT(a, b) AOC_PHASE_CONCAT_(a, b)
+#ifdef AOC_PHASES
+#define AOC_PHASE(name) const ::aoc::phase::Scope AOC_PHASE_CONCAT(aocPhase, __LINE__){name}
+#else
+#define AOC_PHASE(name) static_cast<void>(0)
+#endif
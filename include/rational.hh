@@ -1,86 +1,158 @@
 #pragma once
+#include <bit>
+#include <cstdint>
+#include <limits>
 #include <ostream>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
-template <typename T> struct Rational
+
+namespace rational_detail
+{
+__extension__ typedef __int128 Int128;           // NOLINT(modernize-use-using)
+__extension__ typedef unsigned __int128 UInt128; // NOLINT(modernize-use-using)
+
+// twice as wide as T, so a sum of two products of T's can't overflow
+template <typename T>
+using Wider = std::conditional_t<(sizeof(T) < sizeof(int64_t)), int64_t, Int128>;
+template <typename W>
+using UnsignedWider = std::conditional_t<std::is_same_v<W, int64_t>, uint64_t, UInt128>;
+
+template <typename U> int countrZero(U x)
+{
+    if constexpr (sizeof(U) > sizeof(uint64_t))
+    {
+        auto low = static_cast<uint64_t>(x);
+        return low != 0 ? std::countr_zero(low)
+                        : 64 + std::countr_zero(static_cast<uint64_t>(x >> 64)); // NOLINT
+    }
+    else
+    {
+        return std::countr_zero(x);
+    }
+}
+
+// binary (Stein) gcd: shifts and subtractions only, no divisions
+template <typename U> U steinGcd(U a, U b)
+{
+    if (a == 0)
+    {
+        return b;
+    }
+    if (b == 0)
+    {
+        return a;
+    }
+    auto shift = countrZero(a | b);
+    a >>= countrZero(a);
+    do
+    {
+        b >>= countrZero(b);
+        if (a > b)
+        {
+            std::swap(a, b);
+        }
+        b -= a;
+    } while (b != 0);
+    return a << shift;
+}
+
+#ifdef NDEBUG
+inline constexpr bool CHECK_OVERFLOW = false;
+#else
+inline constexpr bool CHECK_OVERFLOW = true;
+#endif
+} // namespace rational_detail
+
+template <typename T, bool CHECKED = rational_detail::CHECK_OVERFLOW> struct Rational
 {
-    // Invariant d>0, maintained by reduce();
-    // No overflow protection
+    static_assert(sizeof(T) <= sizeof(int64_t), "intermediates are computed at twice T's width");
+    using Wide = rational_detail::Wider<T>;
+
+    // Invariant d>0.  n/d is only brought to lowest terms when an intermediate no longer fits in T
+    // or it's printed: arithmetic is done at twice the width, so until then the gcd can wait.
+    // A result that doesn't fit in T even reduced throws std::overflow_error in debug builds, or
+    // always with CHECKED.
     Rational(T n = T{}, T d = T{1}) : n{n}, d{d}
     {
         if (d == 0)
         {
             throw std::invalid_argument("Denominator cannot be zero");
         }
-        reduce();
+        assign(n, d);
+    }
+
+    explicit operator T() const
+    {
+        return n / d;
     }
 
-    explicit operator T() {
-        return n/d;
+    /// The same value in lowest terms
+    [[nodiscard]] Rational reduced() const
+    {
+        Rational r = *this;
+        r.reduce();
+        return r;
+    }
+    [[nodiscard]] T numerator() const
+    {
+        return reduced().n;
+    }
+    [[nodiscard]] T denominator() const
+    {
+        return reduced().d;
     }
 
-    // everything is passed by value since the representation is small
-    bool operator==(Rational<T> other) const
+    // everything is passed by value since the representation is small.  Comparisons cross
+    // multiply at the wide type, so they don't need lowest terms either
+    bool operator==(Rational other) const
     {
-        return other.d * n == other.n * d;
+        return Wide{other.d} * n == Wide{other.n} * d;
     }
-    bool operator!=(Rational<T> other) const
+    bool operator!=(Rational other) const
     {
         return !(*this == other);
     }
-    bool operator<(Rational<T> other) const
+    bool operator<(Rational other) const
     {
         // if d were allowed to be negative we'd need to check here and possibly reverse the order
-        return n * other.d < d * other.n;
+        return Wide{n} * other.d < Wide{d} * other.n;
     }
-    bool operator>(Rational<T> other) const
+    bool operator>(Rational other) const
     {
         return other < *this;
     }
-    bool operator<=(Rational<T> other) const
+    bool operator<=(Rational other) const
     {
         return !(*this > other);
     }
-    bool operator>=(Rational<T> other) const
+    bool operator>=(Rational other) const
     {
         return !(*this < other);
     }
-    Rational<T>& operator+=(Rational<T> other)
+    Rational& operator+=(Rational other)
     {
-        n *= other.d;
-        n += other.n * d;
-        d *= other.d;
-        reduce();
-        return *this;
+        return assign(Wide{n} * other.d + Wide{other.n} * d, Wide{d} * other.d);
     }
-    Rational<T>& operator-=(Rational<T> other)
+    Rational& operator-=(Rational other)
     {
-        n *= other.d;
-        n -= other.n * d;
-        d *= other.d;
-        reduce();
-        return *this;
+        return assign(Wide{n} * other.d - Wide{other.n} * d, Wide{d} * other.d);
     }
-    Rational<T>& operator*=(Rational<T> other)
+    Rational& operator*=(Rational other)
     {
-        n *= other.n;
-        d *= other.d;
-        reduce();
-        return *this;
+        return assign(Wide{n} * other.n, Wide{d} * other.d);
     }
-    Rational<T>& operator/=(Rational<T> other)
+    Rational& operator/=(Rational other)
     {
         if (other.n == 0)
         {
             throw std::invalid_argument("Divide by zero exception");
         }
-        n *= other.d;
-        d *= other.n;
-        reduce();
-        return *this;
+        return assign(Wide{n} * other.d, Wide{d} * other.n);
     }
-    friend std::ostream& operator<<(std::ostream& os, Rational<T> r)
+    friend std::ostream& operator<<(std::ostream& os, Rational r)
     {
+        r.reduce();
         if (r.d == 1)
         {
             return os << r.n;
@@ -88,95 +160,72 @@ template <typename T> struct Rational
         return os << r.n << '/' << r.d;
     }
 
+    // friends rather than templates so that a plain T on either side converts
+    friend Rational operator+(Rational l, Rational r)
+    {
+        return l += r;
+    }
+    friend Rational operator-(Rational l, Rational r)
+    {
+        return l -= r;
+    }
+    friend Rational operator*(Rational l, Rational r)
+    {
+        return l *= r;
+    }
+    friend Rational operator/(Rational l, Rational r)
+    {
+        return l /= r;
+    }
+    friend Rational operator-(Rational r)
+    {
+        return Rational{} - r;
+    }
+
   private:
-    static T gcdPos(T a, T b)
+    using UWide = rational_detail::UnsignedWider<Wide>;
+
+    static UWide magnitude(Wide x)
     {
-        if (b == 0)
-        {
-            return a;
-        }
-        return gcdPos(b, a % b);
+        return x < 0 ? UWide{0} - static_cast<UWide>(x) : static_cast<UWide>(x);
     }
-    static T gcd(T a, T b)
+    static bool fits(Wide x)
+    {
+        return x >= std::numeric_limits<T>::min() && x <= std::numeric_limits<T>::max();
+    }
+
+    // n/d = wn/wd, reduced only if it has to be to fit back in T
+    Rational& assign(Wide wn, Wide wd)
     {
-        if (a < 0)
+        if (wn == 0)
         {
-            a = -a;
+            wd = 1;
         }
-        if (b < 0)
+        if (wd < 0)
         {
-            b = -b;
+            wn = -wn;
+            wd = -wd;
         }
-        if (a < b)
+        if (!fits(wn) || !fits(wd))
         {
-            std::swap(a, b);
+            auto g = static_cast<Wide>(rational_detail::steinGcd(magnitude(wn), magnitude(wd)));
+            wn /= g;
+            wd /= g;
+            if (CHECKED && (!fits(wn) || !fits(wd)))
+            {
+                throw std::overflow_error("Rational overflow");
+            }
         }
-        return gcdPos(a, b);
+        n = static_cast<T>(wn);
+        d = static_cast<T>(wd);
+        return *this;
     }
     void reduce()
     {
-        T g = gcd(n, d);
+        auto g = static_cast<T>(rational_detail::steinGcd(magnitude(n), magnitude(d)));
         n /= g;
         d /= g;
-        if (d < 0)
-        {
-            n = -n;
-            d = -d;
-        }
     }
     T n;
     T d;
 };
-
-template <typename T> Rational<T> operator+(Rational<T> l, Rational<T> r)
-{
-    return l += r;
-}
-template <typename T> Rational<T> operator+(Rational<T> l, T r)
-{
-    return l += Rational<T>{r};
-}
-template <typename T> Rational<T> operator+(T l, Rational<T> r)
-{
-    return Rational<T>{l} += r;
-}
-template <typename T> Rational<T> operator-(Rational<T> l, Rational<T> r)
-{
-    return l -= r;
-}
-template <typename T> Rational<T> operator-(Rational<T> l, T r)
-{
-    return l -= Rational<T>{r};
-}
-template <typename T> Rational<T> operator-(T l, Rational<T> r)
-{
-    return Rational<T>{l} -= r;
-}
-template <typename T> Rational<T> operator-(Rational<T> l)
-{
-    return Rational<T>{} - l;
-}
-template <typename T> Rational<T> operator*(Rational<T> l, Rational<T> r)
-{
-    return l *= r;
-}
-template <typename T> Rational<T> operator*(Rational<T> l, T r)
-{
-    return l *= Rational<T>{r};
-}
-template <typename T> Rational<T> operator*(T l, Rational<T> r)
-{
-    return Rational<T>{l} *= r;
-}
-template <typename T> Rational<T> operator/(Rational<T> l, Rational<T> r)
-{
-    return l /= r;
-}
-template <typename T> Rational<T> operator/(Rational<T> l, T r)
-{
-    return l /= Rational<T>{r};
-}
-template <typename T> Rational<T> operator/(T l, Rational<T> r)
-{
-    return Rational<T>{l} /= r;
-}
\ No newline at end of file
@@ -0,0 +1,180 @@
+#pragma once
+#include "hash.hh"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+/* Solutions cached on disk by content: a day's entry is only reused while both its input and the
+ * compiled solver are byte-for-byte what produced it.  The solver is identified by the object file
+ * of its day*.cc, found through the list CMake writes at build time (AOC_SOLUTION_OBJECTS), so
+ * editing one day only invalidates that day.  Without the list, any rebuild of the executable
+ * invalidates everything.
+ */
+namespace aoc::cache
+{
+
+struct Entry
+{
+    std::string part1;
+    std::string part2;
+    std::chrono::microseconds duration{};
+};
+
+namespace detail
+{
+inline std::string hex(const Hash::Hasher::Digest& digest)
+{
+    constexpr std::string_view DIGITS = "0123456789abcdef";
+    std::string out;
+    for (auto b : digest)
+    {
+        out += DIGITS[b >> 4U]; // NOLINT(*-magic-numbers)
+        out += DIGITS[b & 0xFU]; // NOLINT(*-magic-numbers)
+    }
+    return out;
+}
+
+inline std::optional<std::string> readFile(const std::filesystem::path& path)
+{
+    std::ifstream ifs{path, std::ios::binary};
+    if (!ifs)
+    {
+        return {};
+    }
+    return std::string{std::istreambuf_iterator<char>{ifs}, {}};
+}
+
+// the object file built from src/<year>/dayDD.cc, if the build left a list of them
+inline std::optional<std::filesystem::path> solverObject(size_t year, size_t day)
+{
+#ifdef AOC_SOLUTION_OBJECTS
+    std::ifstream list{AOC_SOLUTION_OBJECTS};
+    std::ostringstream name;
+    name << "day" << std::setfill('0') << std::setw(2) << day << ".cc";
+    auto dir = std::to_string(year);
+    for (std::string line; std::getline(list, line);)
+    {
+        std::filesystem::path obj{line};
+        if (obj.stem() == name.str() && obj.parent_path().filename() == dir)
+        {
+            return obj;
+        }
+    }
+#else
+    (void)year;
+    (void)day;
+#endif
+    return {};
+}
+
+inline const std::string& executableDigest()
+{
+    static const std::string digest = []
+    {
+        auto exe = readFile("/proc/self/exe");
+        return exe ? hex(Hash::Hasher::sha256Hasher()(*exe)) : std::string{};
+    }();
+    return digest;
+}
+} // namespace detail
+
+/// Hash of what decides a day's answer: the solver's object code and the input bytes
+inline std::string key(size_t year, size_t day, std::string_view input)
+{
+    auto hasher = Hash::Hasher::sha256Hasher();
+    std::string fingerprint;
+    if (auto obj = detail::solverObject(year, day))
+    {
+        if (auto code = detail::readFile(*obj))
+        {
+            fingerprint = detail::hex(hasher(*code));
+        }
+    }
+    if (fingerprint.empty())
+    {
+        fingerprint = detail::executableDigest();
+    }
+    return fingerprint + ":" + detail::hex(hasher(input));
+}
+
+/// cache.json next to answers.json; one entry per day, the most recent.  Safe to share between
+/// threads.
+class ResultCache
+{
+    std::filesystem::path path;
+    nlohmann::json entries = nlohmann::json::object();
+    std::mutex mutex;
+    bool dirty = false;
+
+  public:
+    explicit ResultCache(std::filesystem::path file) : path{std::move(file)}
+    {
+        std::ifstream ifs{path};
+        if (!ifs)
+        {
+            return;
+        }
+        // a damaged cache is only a slower run
+        auto parsed = nlohmann::json::parse(ifs, nullptr, false);
+        if (parsed.is_object())
+        {
+            entries = std::move(parsed);
+        }
+    }
+
+    std::optional<Entry> find(size_t year, size_t day, const std::string& key)
+    {
+        std::lock_guard lk{mutex};
+        auto y = entries.find(std::to_string(year));
+        if (y == entries.end())
+        {
+            return {};
+        }
+        auto d = y->find(std::to_string(day));
+        if (d == y->end() || !d->is_object() || d->value("key", "") != key)
+        {
+            return {};
+        }
+        return Entry{d->value("part1", ""), d->value("part2", ""),
+                     std::chrono::microseconds{d->value("duration_us", int64_t{})}};
+    }
+
+    void store(size_t year, size_t day, const std::string& key, const Entry& entry)
+    {
+        std::lock_guard lk{mutex};
+        entries[std::to_string(year)][std::to_string(day)] = {
+            {"key", key},
+            {"part1", entry.part1},
+            {"part2", entry.part2},
+            {"duration_us", entry.duration.count()}};
+        dirty = true;
+    }
+
+    // written to a temporary and renamed over, so an interrupted run can't truncate it
+    void save()
+    {
+        std::lock_guard lk{mutex};
+        if (!dirty)
+        {
+            return;
+        }
+        auto tmp = path;
+        tmp += ".tmp";
+        {
+            std::ofstream ofs{tmp};
+            ofs << entries.dump(2) << "\n";
+        }
+        std::filesystem::rename(tmp, path);
+        dirty = false;
+    }
+};
+
+} // namespace aoc::cache
@@ -1,5 +1,7 @@
 #pragma once
 #include "aoc.hh"
+#include "input.hh"
+#include "inputstream.hh"
 
 namespace aoc
 {
@@ -121,6 +123,44 @@ template <> struct IsSlow<2016, 14> : std::true_type
 {
 };
 
+// Days split into parse + independent parts, see aoc.hh
+template <> struct HasParts<2015, 4> : std::true_type
+{
+};
+template <> struct HasParts<2017, 15> : std::true_type
+{
+};
+
+template <> std::shared_ptr<const Parsed<2015, 4>> parse<2015, 4>(std::istream& input);
+template <> Part_t<2015, 4> solvePart1<2015, 4>(const Parsed<2015, 4>& input);
+template <> Part_t<2015, 4> solvePart2<2015, 4>(const Parsed<2015, 4>& input);
+template <> std::shared_ptr<const Parsed<2017, 15>> parse<2017, 15>(std::istream& input);
+template <> Part_t<2017, 15> solvePart1<2017, 15>(const Parsed<2017, 15>& input);
+template <> Part_t<2017, 15> solvePart2<2017, 15>(const Parsed<2017, 15>& input);
+
+// Single-pass days that read their input in chunks, see inputstream.hh
+template <> struct IsStreaming<2015, 1> : std::true_type
+{
+};
+template <> struct IsStreaming<2015, 3> : std::true_type
+{
+};
+template <> struct IsStreaming<2017, 9> : std::true_type
+{
+};
+template <> struct IsStreaming<2017, 11> : std::true_type
+{
+};
+template <> struct IsStreaming<2018, 5> : std::true_type
+{
+};
+
+template <> Solution_t<2015, 1> solve<2015, 1>(InputStream& input);
+template <> Solution_t<2015, 3> solve<2015, 3>(InputStream& input);
+template <> Solution_t<2017, 9> solve<2017, 9>(InputStream& input);
+template <> Solution_t<2017, 11> solve<2017, 11>(InputStream& input);
+template <> Solution_t<2018, 5> solve<2018, 5>(InputStream& input);
+
 template <> Solution_t<2015, 1> solve<2015, 1>(std::istream& input);
 template <> Solution_t<2015, 2> solve<2015, 2>(std::istream& input);
 template <> Solution_t<2015, 3> solve<2015, 3>(std::istream& input);
@@ -225,6 +265,11 @@ template <> Solution_t<2018, 23> solve<2018, 23>(std::istream& input);
 template <> Solution_t<2018, 24> solve<2018, 24>(std::istream& input);
 template <> Solution_t<2018, 25> solve<2018, 25>(std::istream& input);
 
+// Days that parse straight out of the mapped input
+template <> Solution_t<2018, 3> solve<2018, 3>(const InputView& input);
+template <> Solution_t<2018, 6> solve<2018, 6>(const InputView& input);
+template <> Solution_t<2018, 10> solve<2018, 10>(const InputView& input);
+
 template <> Solution_t<2024, 1> solve<2024, 1>(std::istream& input);
 template <> Solution_t<2024, 2> solve<2024, 2>(std::istream& input);
 template <> Solution_t<2024, 3> solve<2024, 3>(std::istream& input);
@@ -0,0 +1,294 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace aoc
+{
+
+/// Work-stealing thread pool.  Every worker owns a deque; it pops its own work from the back and,
+/// when that runs dry, steals from the front of the other workers' deques.  Tasks submitted from
+/// outside the pool are dealt round-robin across the deques.
+class ThreadPool
+{
+  public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(size_t threads = std::thread::hardware_concurrency())
+    {
+        threads = std::max<size_t>(threads, 1);
+        for (size_t i = 0; i < threads; ++i)
+        {
+            queues.push_back(std::make_unique<Queue>());
+        }
+        for (size_t i = 0; i < threads; ++i)
+        {
+            workers.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard lk{sleepMutex};
+            stopping = true;
+        }
+        wakeup.notify_all();
+        for (auto& w : workers)
+        {
+            w.join();
+        }
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return workers.size();
+    }
+
+    /// Process-wide pool, one worker per hardware thread unless setSharedSize() said otherwise,
+    /// started on first use
+    static ThreadPool& shared()
+    {
+        static ThreadPool pool{sharedSize};
+        return pool;
+    }
+
+    /// Worker count for shared(); has no effect once it has started
+    static void setSharedSize(size_t threads)
+    {
+        sharedSize = threads;
+    }
+
+    void submit(Task task)
+    {
+        unfinished.fetch_add(1);
+        auto idx = (currentPool == this) ? currentIndex : nextQueue.fetch_add(1) % queues.size();
+        {
+            std::lock_guard lk{queues[idx]->mutex};
+            queues[idx]->tasks.push_back(std::move(task));
+        }
+        {
+            // queued is bumped under sleepMutex so a worker can't miss the wakeup between checking
+            // its predicate and going to sleep
+            std::lock_guard lk{sleepMutex};
+            ++queued;
+        }
+        wakeup.notify_all();
+    }
+
+    /// Blocks until every submitted task has finished.  A caller that is itself a pool worker runs
+    /// queued tasks while it waits rather than tying up its thread.  Rethrows the first exception
+    /// that escaped a task.
+    void wait()
+    {
+        helpUntil([this] { return unfinished.load() == 0; });
+        std::lock_guard lk{sleepMutex};
+        if (failure)
+        {
+            std::rethrow_exception(std::exchange(failure, nullptr));
+        }
+    }
+
+  private:
+    friend class TaskGroup;
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> nextQueue{};
+    std::atomic<size_t> unfinished{};
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeup;
+    size_t queued{};
+    bool stopping{};
+    std::exception_ptr failure;
+
+    static inline thread_local ThreadPool* currentPool{};
+    static inline thread_local size_t currentIndex{};
+    static inline size_t sharedSize = std::thread::hardware_concurrency();
+
+    std::optional<Task> popOwn(size_t idx)
+    {
+        auto& q = *queues[idx];
+        std::lock_guard lk{q.mutex};
+        if (q.tasks.empty())
+        {
+            return {};
+        }
+        auto task = std::move(q.tasks.back());
+        q.tasks.pop_back();
+        return task;
+    }
+
+    std::optional<Task> steal(size_t thief)
+    {
+        for (size_t off = 1; off <= queues.size(); ++off)
+        {
+            auto& q = *queues[(thief + off) % queues.size()];
+            std::lock_guard lk{q.mutex};
+            if (!q.tasks.empty())
+            {
+                auto task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+                return task;
+            }
+        }
+        return {};
+    }
+
+    // runs queued tasks until done() holds; done must be re-signalled through notifyAll
+    template <typename Pred> void helpUntil(Pred done)
+    {
+        while (!done())
+        {
+            if (runOne())
+            {
+                continue;
+            }
+            std::unique_lock lk{sleepMutex};
+            wakeup.wait(lk, [&] { return done() || queued > 0; });
+        }
+    }
+
+    void notifyAll()
+    {
+        std::lock_guard lk{sleepMutex};
+        wakeup.notify_all();
+    }
+
+    bool runOne()
+    {
+        auto home = (currentPool == this) ? currentIndex : 0;
+        auto task = popOwn(home);
+        if (!task)
+        {
+            task = steal(home);
+        }
+        if (!task)
+        {
+            return false;
+        }
+        {
+            std::lock_guard lk{sleepMutex};
+            --queued;
+        }
+        try
+        {
+            (*task)();
+        }
+        catch (...)
+        {
+            std::lock_guard lk{sleepMutex};
+            if (!failure)
+            {
+                failure = std::current_exception();
+            }
+        }
+        if (unfinished.fetch_sub(1) == 1)
+        {
+            notifyAll();
+        }
+        return true;
+    }
+
+    void workerLoop(size_t idx)
+    {
+        currentPool = this;
+        currentIndex = idx;
+        for (;;)
+        {
+            if (runOne())
+            {
+                continue;
+            }
+            std::unique_lock lk{sleepMutex};
+            wakeup.wait(lk, [this] { return stopping || queued > 0; });
+            if (stopping && queued == 0)
+            {
+                return;
+            }
+        }
+    }
+};
+
+/// A batch of tasks on a pool that can be waited for independently of anything else the pool is
+/// running.  Waiting helps run queued work, so it's safe to wait from inside a pool task.
+class TaskGroup
+{
+    ThreadPool& pool;
+    std::atomic<size_t> pending{};
+    std::mutex failureMutex;
+    std::exception_ptr failure;
+
+  public:
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::shared()) : pool{pool} {}
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup(TaskGroup&&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    TaskGroup& operator=(TaskGroup&&) = delete;
+    ~TaskGroup()
+    {
+        // tasks hold a reference to this group
+        pool.helpUntil([this] { return pending.load() == 0; });
+    }
+
+    void run(ThreadPool::Task task)
+    {
+        pending.fetch_add(1);
+        pool.submit(
+            // the group may be gone once pending drops to 0, so don't reach the pool through it
+            [this, &pool = pool, task = std::move(task)]
+            {
+                try
+                {
+                    task();
+                }
+                catch (...)
+                {
+                    std::lock_guard lk{failureMutex};
+                    if (!failure)
+                    {
+                        failure = std::current_exception();
+                    }
+                }
+                if (pending.fetch_sub(1) == 1)
+                {
+                    pool.notifyAll();
+                }
+            });
+    }
+
+    /// Blocks until every task run() on this group has finished; rethrows the first failure
+    void wait()
+    {
+        pool.helpUntil([this] { return pending.load() == 0; });
+        std::lock_guard lk{failureMutex};
+        if (failure)
+        {
+            std::rethrow_exception(std::exchange(failure, nullptr));
+        }
+    }
+};
+
+} // namespace aoc
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "numscan.hh"
 #include <bitset>
 #include <charconv>
 #include <ctre.hpp>
@@ -65,12 +66,11 @@ template <typename T = int> T toNum(std::string_view sv)
     return val;
 }
 
-template <typename T = int> inline std::vector<T> readNumbers(std::string_view s)
+// every `-?\d+` in s, see NumberScanner
+template <ScannableInt T = int> inline std::vector<T> readNumbers(std::string_view s)
 {
-    static auto constexpr NUMS = ctll::fixed_string(R"((-?\d+))");
-    auto v =
-        ctre::search_all<NUMS>(s) |
-        std::views::transform([](auto m) { return m.template get<1>().template to_number<T>(); });
-    return std::ranges::to<std::vector>(v);
+    std::vector<T> res;
+    scanNumbers(s, res);
+    return res;
 }
 } // namespace aoc
@@ -1,6 +1,5 @@
 #include "aoc.hh"
-#include <numeric>
-#include <ranges>
+#include "inputstream.hh"
 
 /* https://adventofcode.com/2015/day/1
  */
@@ -9,13 +8,42 @@ namespace aoc
 constexpr size_t YEAR = 2015;
 constexpr size_t DAY = 1;
 
+namespace
+{
+struct Floors
+{
+    ssize_t floor{};
+    ssize_t position{};
+    ssize_t firstBasement{};
+
+    void feed(std::string_view chunk)
+    {
+        for (auto c : chunk)
+        {
+            if (c != '(' && c != ')')
+            {
+                continue;
+            }
+            ++position;
+            floor += c == '(' ? 1 : -1;
+            if (floor == -1 && firstBasement == 0)
+            {
+                firstBasement = position;
+            }
+        }
+    }
+};
+} // namespace
+
+template <> SsizeSolution solve<YEAR, DAY>(InputStream& input)
+{
+    auto floors = parseStream<Floors>(input);
+    return {floors.floor, floors.firstBasement};
+}
+
 template <> SsizeSolution solve<YEAR, DAY>(std::istream& input)
 {
-    auto steps = slurp(input);
-    auto v = steps | std::views::transform([](auto c) { return c == '(' ? 1 : -1; });
-    std::vector<int> floors;
-    std::partial_sum(v.begin(), v.end(), back_inserter(floors));
-    auto firstBasement = std::ranges::find(floors, -1);
-    return {floors.back(), firstBasement - floors.begin() + 1};
+    IstreamStream stream{input};
+    return solve<YEAR, DAY>(static_cast<InputStream&>(stream));
 }
 } // namespace aoc
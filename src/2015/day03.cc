@@ -1,6 +1,6 @@
 #include "aoc.hh"
-#include <algorithm> // IWYU pragma: keep - apple clangd seems to think fold_left is in <ranges>
-#include <ranges>
+#include "inputstream.hh"
+#include <array>
 #include <set>
 
 /* https://adventofcode.com/2015/day/3
@@ -18,42 +18,63 @@ template <size_t N> struct Locations
     std::array<Loc, N> current;
     size_t idx{};
     std::set<Loc> visited = {current[0]};
+
+    void step(Loc delta)
+    {
+        current[idx].first += delta.first;
+        current[idx].second += delta.second;
+        visited.insert(current[idx]);
+        idx = (idx + 1) % N;
+    }
 };
 
-template <size_t N> Locations<N> step(Locations<N> ls, typename Locations<N>::Loc delta)
+// Santa alone and Santa with Robo-Santa follow the same moves, so both walk in one pass
+struct Deliveries
 {
-    ls.current[ls.idx].first += delta.first;
-    ls.current[ls.idx].second += delta.second;
-    ls.visited.insert(ls.current[ls.idx]);
-    ls.idx = (ls.idx + 1) % N;
-    return ls;
-}
-} // namespace
+    Locations<1> alone;
+    Locations<2> together;
 
-template <> SsizeSolution solve<YEAR, DAY>(std::istream& input)
-{
-    auto toMoves = [](auto c)
+    void feed(std::string_view chunk)
     {
-        switch (c)
+        for (auto c : chunk)
         {
-        case '^':
-            return std::make_pair(0, 1);
-        case 'v':
-            return std::make_pair(0, -1);
-        case '>':
-            return std::make_pair(1, 0);
-        case '<':
-            return std::make_pair(-1, 0);
-        default:
-            throw std::invalid_argument("Unknown character");
+            std::pair<int, int> delta;
+            switch (c)
+            {
+            case '^':
+                delta = {0, 1};
+                break;
+            case 'v':
+                delta = {0, -1};
+                break;
+            case '>':
+                delta = {1, 0};
+                break;
+            case '<':
+                delta = {-1, 0};
+                break;
+            case '\n':
+            case '\r':
+                continue;
+            default:
+                throw std::invalid_argument("Unknown character");
+            }
+            alone.step(delta);
+            together.step(delta);
         }
-    };
+    }
+};
+} // namespace
 
-    auto instructions = slurp(input);
-    auto view = instructions | std::views::transform(toMoves);
-    auto part1Result = std::ranges::fold_left(view, Locations<1>{}, step<1>);
-    auto part2Result = std::ranges::fold_left(view, Locations<2>{}, step<2>);
+template <> SsizeSolution solve<YEAR, DAY>(InputStream& input)
+{
+    auto deliveries = parseStream<Deliveries>(input);
+    return {std::ssize(deliveries.alone.visited), std::ssize(deliveries.together.visited)};
+}
 
-    return {std::ssize(part1Result.visited), std::ssize(part2Result.visited)};
+template <> SsizeSolution solve<YEAR, DAY>(std::istream& input)
+{
+    IstreamStream stream{input};
+    return solve<YEAR, DAY>(static_cast<InputStream&>(stream));
 }
 } // namespace aoc
@@ -1,9 +1,7 @@
 #include "aoc.hh"
-#include "hash.hh"
+#include "mining.hh"
 #include "util.hh"
-#include <algorithm>
-#include <ranges>
-#include <thread>
+#include <memory>
 
 /* https://adventofcode.com/2015/day/4
  */
@@ -14,90 +12,45 @@ constexpr size_t DAY = 4;
 
 namespace
 {
-template <ssize_t N> bool hasStartingZeros(const std::vector<uint8_t>& md5)
+ssize_t firstHit(const std::string& prefix, int zeros)
 {
-    if constexpr (N % 2 == 1)
-    {
-        constexpr uint8_t FIRST_DIGIT = 0xF0;
-        if (md5[N / 2] & FIRST_DIGIT)
-        {
-            return false;
-        }
-    }
-    auto view = md5 | std::views::take(N / 2);
-    return std::ranges::all_of(view, [](auto c) { return c == 0; });
+    ssize_t found{};
+    mining::mine(prefix, zeros,
+                 [&found](const mining::Hit& hit)
+                 {
+                     found = static_cast<ssize_t>(hit.index);
+                     return false;
+                 });
+    return found;
 }
+} // namespace
 
-template <ssize_t N>
-std::optional<ssize_t> mineSlice(const std::string& prefix, ssize_t from, ssize_t count,
-                                 Hash::Hasher& hasher)
+template <> struct Parsed<YEAR, DAY>
 {
-    auto appendN = [&prefix](auto n) { return prefix + std::to_string(n); };
+    std::string prefix;
+};
 
-    auto view = std::views::iota(from, from + count) | std::views::transform(appendN) |
-                std::views::transform([&hasher](const std::string& s) { return hasher(s); });
-    auto found = std::ranges::find_if(view, hasStartingZeros<N>);
-    return found == view.end() ? std::optional<ssize_t>{} : found - view.begin() + from;
+template <> std::shared_ptr<const Parsed<YEAR, DAY>> parse<YEAR, DAY>(std::istream& input)
+{
+    return std::make_shared<const Parsed<YEAR, DAY>>(std::string{trim(slurp(input))});
 }
 
-template <ssize_t N, ssize_t BLOCKSIZE>
-// NOLINTNEXTLINE (performance-unnecessary-value-param)
-void mine(std::string prefix, std::atomic<ssize_t>& counter, std::atomic<ssize_t>& result)
+template <> Part_t<YEAR, DAY> solvePart1<YEAR, DAY>(const Parsed<YEAR, DAY>& input)
 {
-    auto hasher = Hash::Hasher::md5Hasher();
-    for (;;)
-    {
-        if (result.load() != 0)
-        {
-            break;
-        }
-        ssize_t from = counter.fetch_add(BLOCKSIZE);
-        auto res = mineSlice<N>(prefix, from, BLOCKSIZE, hasher);
-        if (res)
-        {
-            ssize_t prev{};
-            do
-            {
-                prev = result.load();
-
-                if (prev != 0 && prev < *res)
-                {
-                    return;
-                }
-            } while (!result.compare_exchange_weak(prev, *res));
-        }
-    }
+    constexpr int PART1_ZEROS = 5;
+    return firstHit(input.prefix, PART1_ZEROS);
 }
 
-template <ssize_t N> ssize_t parallelSolve(const std::string& prefix)
+// part 2 re-searches part 1's range, but it runs concurrently with part 1, so that costs little
+// wall time
+template <> Part_t<YEAR, DAY> solvePart2<YEAR, DAY>(const Parsed<YEAR, DAY>& input)
 {
-    constexpr ssize_t BLOCKSIZE = 10000;
-    auto concur = std::thread::hardware_concurrency();
-    std::vector<std::thread> miners;
-    std::atomic<ssize_t> counter;
-    std::atomic<ssize_t> result;
-    for (auto _ : std::views::iota(0UL, concur))
-    {
-        miners.emplace_back(mine<N, BLOCKSIZE>, prefix, std::ref(counter), std::ref(result));
-    }
-    for (auto& t : miners)
-    {
-        t.join();
-    }
-    return result.load();
+    constexpr int PART2_ZEROS = 6;
+    return firstHit(input.prefix, PART2_ZEROS);
 }
 
-} // namespace
-
 template <> SsizeSolution solve<YEAR, DAY>(std::istream& input)
 {
-    auto prefix = std::string{trim(slurp(input))};
-    constexpr ssize_t PART1_ZEROS = 5;
-    constexpr ssize_t PART2_ZEROS = 6;
-    // this recomputes the first p1 hashes, but p2 is significantly larger so the duplicate p1 is
-    // minor
-    auto p1 = parallelSolve<PART1_ZEROS>(prefix);
-    auto p2 = parallelSolve<PART2_ZEROS>(prefix);
-    return {p1, p2};
+    return solveParts<YEAR, DAY>(input);
 }
 } // namespace aoc
@@ -1,5 +1,7 @@
 #include "aoc.hh"
+#include "arena.hh"
 #include <iostream>
+#include <memory_resource>
 #include <queue>
 #include <scn/scan.h>
 
@@ -205,7 +207,9 @@ template <resource_t DEGEN> struct ActionPoint
 template <resource_t DEGEN> ssize_t optimize(ActionPoint<DEGEN> g)
 {
     g.playerHealth -= DEGEN;
-    std::priority_queue<ActionPoint<DEGEN>, std::deque<ActionPoint<DEGEN>>, std::greater<>> dijk;
+    using Point = ActionPoint<DEGEN>;
+    std::priority_queue<Point, std::pmr::vector<Point>, std::greater<>> dijk{
+        std::greater<>{}, std::pmr::vector<Point>{arena()}};
     dijk.push(g);
 
     while (dijk.size())
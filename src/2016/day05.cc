@@ -1,9 +1,7 @@
 #include "aoc.hh"
-#include "hash.hh"
+#include "mining.hh"
 #include "util.hh"
-#include <algorithm>
 #include <bitset>
-#include <ranges>
 
 /* https://adventofcode.com/2016/day/5
  */
@@ -14,61 +12,35 @@ constexpr size_t DAY = 5;
 
 namespace
 {
-template <int N> bool hasStartingZeros(const std::vector<uint8_t>& md5)
-{
-    if constexpr (N % 2 == 1)
-    {
-        constexpr auto FIRST_DIGIT = 0xF0;
-        if (md5[N / 2] & FIRST_DIGIT)
-        {
-            return false;
-        }
-    }
-    auto view = md5 | std::views::take(N / 2);
-    return std::ranges::all_of(view, [](auto c) { return c == 0; });
-}
-
+// hits come back in index order from every thread, so the password fills in deterministically
 template <int LEADING_ZEROS> StringSolution crack(const std::string& prefix)
 {
-    auto hasher = Hash::Hasher::md5Hasher();
-    auto appendN = [&prefix](auto n) { return prefix + std::to_string(n); };
-    {
-        using namespace std::views;
-        [[maybe_unused]] constexpr auto SECOND_DIGIT = 0x0F;
-        [[maybe_unused]] constexpr int PASSWORD_LENGTH = 8;
-        [[maybe_unused]] constexpr int BASE = 16;
-        auto view = iota(0) | transform(appendN) |
-                    transform([&hasher](const std::string& s) { return hasher(s); }) |
-                    filter(hasStartingZeros<LEADING_ZEROS>) |
-                    transform(
-                        [](auto md5) -> std::pair<int, int> {
-                            return std::make_pair(md5[LEADING_ZEROS / 2] & SECOND_DIGIT,
-                                                  md5[LEADING_ZEROS / 2 + 1] >> 4);
-                        });
-        std::bitset<PASSWORD_LENGTH> seen;
-        int part1{};
-        int part2{};
-        for (int i{}; auto [d1, d2] : view)
-        {
-            if (i++ < PASSWORD_LENGTH)
-            {
-                part1 = part1 * BASE + d1;
-            }
-
-            if (d1 < PASSWORD_LENGTH && !seen[d1])
-            {
-                seen.set(d1);
-                // d1 = 0 means shift 7 nibbles, d1 = 7 means shift 0
-                part2 |= d2 << ((PASSWORD_LENGTH - 1 - d1) * 4);
-            }
+    constexpr auto SECOND_DIGIT = 0x0F;
+    constexpr int PASSWORD_LENGTH = 8;
+    constexpr int BASE = 16;
+    std::bitset<PASSWORD_LENGTH> seen;
+    int part1{};
+    int part2{};
+    int found{};
+    mining::mine(prefix, LEADING_ZEROS,
+                 [&](const mining::Hit& hit)
+                 {
+                     int d1 = hit.digest[LEADING_ZEROS / 2] & SECOND_DIGIT;
+                     int d2 = hit.digest[LEADING_ZEROS / 2 + 1] >> 4;
+                     if (found++ < PASSWORD_LENGTH)
+                     {
+                         part1 = part1 * BASE + d1;
+                     }
 
-            if (seen.all())
-            {
-                break;
-            }
-        }
-        return {toHex(part1), toHex(part2)};
-    }
+                     if (d1 < PASSWORD_LENGTH && !seen[d1])
+                     {
+                         seen.set(d1);
+                         // d1 = 0 means shift 7 nibbles, d1 = 7 means shift 0
+                         part2 |= d2 << ((PASSWORD_LENGTH - 1 - d1) * 4);
+                     }
+                     return !seen.all();
+                 });
+    return {toHex(part1), toHex(part2)};
 }
 } // namespace
 
@@ -1,7 +1,9 @@
 #include "aoc.hh"
+#include "arena.hh"
 #include <algorithm>
 #include <cassert>
 #include <functional>
+#include <memory_resource>
 #include <queue>
 #include <ranges>
 #include <set>
@@ -99,10 +101,10 @@ template <int N> struct ArrayState
         return true;
     }
 
-    [[nodiscard]] std::vector<ArrayState<N>> nextStates() const
+    // replaces the contents of `nexts`, so one buffer serves the whole search
+    void nextStates(std::pmr::vector<ArrayState<N>>& nexts) const
     {
-        std::vector<ArrayState<N>> nexts;
-        std::vector<int> dirs;
+        nexts.clear();
         for (auto dir : {-1, 1})
         {
             if ((dir == -1 && elevator() <= 1) || (dir == 1 && elevator() >= FLOORS))
@@ -141,7 +143,6 @@ template <int N> struct ArrayState
                 }
             }
         }
-        return nexts;
     }
 
     using Sig = Rep;
@@ -153,8 +154,10 @@ template <int N> struct ArrayState
 
 template <typename St> int solve(St s)
 {
-    std::set<typename St::Sig> seen;
-    std::priority_queue<St, std::vector<St>, std::greater<>> frontier;
+    std::pmr::set<typename St::Sig> seen{arena()};
+    std::priority_queue<St, std::pmr::vector<St>, std::greater<>> frontier{
+        std::greater<>{}, std::pmr::vector<St>{arena()}};
+    std::pmr::vector<St> nexts{arena()};
     seen.insert(s.sig());
     frontier.push(s);
     while (frontier.size())
@@ -165,7 +168,8 @@ template <typename St> int solve(St s)
         {
             return s.steps;
         }
-        for (auto& ns : s.nextStates())
+        s.nextStates(nexts);
+        for (auto& ns : nexts)
         {
             if (!seen.contains(ns.sig()))
             {
@@ -1,5 +1,7 @@
 #include "aoc.hh"
+#include "arena.hh"
 #include <deque>
+#include <memory_resource>
 #include <set>
 
 /* https://adventofcode.com/2016/day/13
@@ -34,8 +36,8 @@ constexpr auto DIRS = std::array<Coord, 4>{{{1, 0}, {-1, 0}, {0, 1}, {0, -1}}};
 int part1(int seed)
 {
     constexpr auto TARGET = std::make_pair(31, 39);
-    std::set<Coord> seen;
-    std::deque<Path> frontier;
+    std::pmr::set<Coord> seen{arena()};
+    std::pmr::deque<Path> frontier{arena()};
     Coord start = {1, 1};
     seen.insert(start);
     frontier.push_back({start, 0});
@@ -66,8 +68,8 @@ int part1(int seed)
 int part2(int seed)
 {
     constexpr auto MAX_STEPS = 50;
-    std::set<Coord> seen;
-    std::deque<Path> frontier;
+    std::pmr::set<Coord> seen{arena()};
+    std::pmr::deque<Path> frontier{arena()};
     Coord start = {1, 1};
     seen.insert(start);
     frontier.push_back({start, 0});
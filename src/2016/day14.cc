@@ -1,9 +1,12 @@
 #include "aoc.hh"
-#include "hash.hh"
-#include <algorithm>
-#include <deque>
+#include "md5.hh"
+#include "mining.hh"
+#include <array>
+#include <bit>
 #include <optional>
 #include <ranges>
+#include <string>
+#include <vector>
 
 /* https://adventofcode.com/2016/day/14
  */
@@ -31,17 +34,6 @@ auto splitDigits(const auto& digest)
     return res;
 }
 
-// We need to do 2017 * 20k+ hashes, allocating a string here costs 3 seconds of runtime.  No
-// observed difference with passing out parameter/not initializing
-auto toHexChars(const auto& digest)
-{
-    static constexpr std::string_view DIGITS = "0123456789abcdef";
-    std::array<char, LEN * 2> res{};
-    std::ranges::copy(splitDigits(digest) | std::views::transform([](auto c) { return DIGITS[c]; }),
-                      res.begin());
-    return res;
-}
-
 // using splitDigits instead of unrolling the nibbles is marginally slower but cleaner
 template <int REP> std::optional<uint8_t> findRepeat(const auto& digest)
 {
@@ -90,66 +82,122 @@ template <int REP> auto findRepeats(const auto& digest)
     return repeats;
 }
 
-template <typename F> int generateOTPs(const std::string& seed, F& f)
+constexpr auto WINDOW = 1000;
+
+// what the key search needs from one hash: its first triple and the digits it has five in a row of
+struct Key
 {
-    using Digest = decltype(f(std::declval<std::string>()));
+    int8_t triple;
+    uint16_t quints;
+};
 
-    constexpr auto WINDOW = 1000UZ;
-    constexpr auto TARGET = 64;
-    constexpr auto FIRST_REPEATS = 3;
-    constexpr auto SECOND_REPEATS = 5;
+// one chunk of indices is LANES * CHUNK_BATCHES hashes, enough to outweigh the handoff for part 1
+constexpr uint64_t CHUNK_BATCHES = 16;
+constexpr uint64_t CHUNK = Hash::md5::LANES * CHUNK_BATCHES;
 
-    auto appendN = [&seed](auto n) { return seed + std::to_string(n); };
-    std::deque<Digest> hashes;
-    std::deque<uint16_t> repeats;
-    int otps{};
-    for (int n{}; hashes.size() < WINDOW;)
+// Rehashes each lane's digest as its 32 character lowercase hex string.  The hex goes straight into
+// the message words of a single padded block, two words per digest word, so no lane ever leaves
+// the vector registers
+void stretch(Hash::md5::State<Hash::md5::Lanes>& state, int rounds)
+{
+    using Hash::md5::Lanes;
+    constexpr uint32_t HEX_BYTES = 32;
+    constexpr uint32_t NIBBLE = 0xF;
+    constexpr uint32_t ZEROS = 0x30303030;     // '0' in every byte
+    constexpr uint32_t OVER_NINE = 0x06060606; // pushes 10..15 into bit 4 of each byte
+    constexpr uint32_t LOW_BITS = 0x01010101;
+    constexpr uint32_t TO_LETTERS = 'a' - '0' - 10;
+
+    // hex of the two low bytes of y, high nibble first as it's printed
+    auto hex = [](Lanes y)
     {
-        hashes.push_back(f(appendN(n++)));
-        repeats.push_back(findRepeats<SECOND_REPEATS>(hashes.back()));
-    }
-    for (int idx{}; otps < TARGET; ++idx)
+        Lanes t = ((y >> 4) & NIBBLE) | ((y & NIBBLE) << 8) | (((y >> 12) & NIBBLE) << 16) |
+                  (((y >> 8) & NIBBLE) << 24);
+        return t + ZEROS + (((t + OVER_NINE) >> 4) & LOW_BITS) * TO_LETTERS;
+    };
+
+    std::array<Lanes, 16> block{};
+    block[8] = Lanes{} + 0x80;
+    block[14] = Lanes{} + HEX_BYTES * 8;
+    for (auto _ : std::views::iota(0, rounds))
     {
-        auto h = hashes.front();
-        hashes.pop_front();
-        repeats.pop_front();
-        hashes.push_back(f(appendN(idx + WINDOW)));
-        repeats.push_back(findRepeats<SECOND_REPEATS>(hashes.back()));
-        auto tpl = findRepeat<FIRST_REPEATS>(h);
-        if (!tpl)
+        for (size_t i = 0; i < state.h.size(); ++i)
         {
-            continue;
+            block[2 * i] = hex(state.h[i] & 0xFFFF);
+            block[2 * i + 1] = hex(state.h[i] >> 16);
         }
-        if (std::ranges::any_of(repeats, [&tpl](const auto& s) { return s & 1 << *tpl; }))
+        state = {};
+        state.compress(block);
+    }
+}
+
+std::vector<Key> keyChunk(const std::string& seed, int rounds, uint64_t chunk)
+{
+    constexpr auto FIRST_REPEATS = 3;
+    constexpr auto SECOND_REPEATS = 5;
+
+    std::vector<Key> keys;
+    keys.reserve(CHUNK);
+    Hash::md5::CounterHasher hasher{seed, chunk * CHUNK};
+    Hash::md5::State<Hash::md5::Lanes> state;
+    Hash::md5::Digest digest;
+    for (auto _ : std::views::iota(0UZ, CHUNK_BATCHES))
+    {
+        hasher.hash(state);
+        stretch(state, rounds);
+        for (size_t lane = 0; lane < Hash::md5::LANES; ++lane)
         {
-            ++otps;
-            if (otps == TARGET)
-            {
-                return idx;
-            }
+            Hash::md5::store(state, lane, digest);
+            auto triple = findRepeat<FIRST_REPEATS>(digest);
+            keys.push_back({triple ? static_cast<int8_t>(*triple) : int8_t{-1},
+                            findRepeats<SECOND_REPEATS>(digest)});
         }
     }
-    return 0;
+    return keys;
+}
+
+// The pool hashes ahead while this walks the indices in order.  Index i is only decided once the
+// hash of i + WINDOW has arrived, and by then lastQuint[d] holds the latest index up to there with
+// five d's in a row, so checking i's triple is one comparison
+int generateOTPs(const std::string& seed, int rounds)
+{
+    constexpr auto TARGET = 64;
+
+    std::array<int, 16> lastQuint;
+    lastQuint.fill(-1);
+    std::array<int8_t, WINDOW + 1> triples{};
+    int otps{};
+    int next{};
+    int found{};
+    mining::orderedChunks([&seed, rounds](uint64_t chunk) { return keyChunk(seed, rounds, chunk); },
+                          [&](const Key& key)
+                          {
+                              for (auto q = key.quints; q != 0; q &= q - 1)
+                              {
+                                  lastQuint[std::countr_zero(q)] = next;
+                              }
+                              triples[next % triples.size()] = key.triple;
+                              auto idx = next++ - WINDOW;
+                              if (idx < 0)
+                              {
+                                  return true;
+                              }
+                              auto tpl = triples[idx % triples.size()];
+                              if (tpl >= 0 && lastQuint[tpl] > idx && ++otps == TARGET)
+                              {
+                                  found = idx;
+                                  return false;
+                              }
+                              return true;
+                          });
+    return found;
 }
 } // namespace
 template <> Solution_t<YEAR, DAY> solve<YEAR, DAY>(std::istream& input)
 {
+    constexpr auto STRETCH = 2016;
     std::string seed;
     input >> seed;
-    auto hasher = Hash::Hasher::md5Hasher();
-    auto stretchedHasher = [&hasher](const std::string& message)
-    {
-        constexpr auto STRETCH = 2016;
-        constexpr auto LEN = 16UZ;
-        std::array<char, LEN * 2> str{};
-        auto hash = hasher.digest<LEN>(message);
-        for (auto _ : std::views::iota(0, STRETCH))
-        {
-            str = toHexChars(hash);
-            hash = hasher.digest<LEN>(std::string_view{str.begin(), str.end()});
-        }
-        return hash;
-    };
-    return {generateOTPs(seed, hasher), generateOTPs(seed, stretchedHasher)};
+    return {generateOTPs(seed, 0), generateOTPs(seed, STRETCH)};
 }
 } // namespace aoc
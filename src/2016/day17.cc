@@ -1,8 +1,10 @@
 #include "aoc.hh"
-#include "hash.hh"
-#include <deque>
+#include "md5.hh"
+#include "threadpool.hh"
+#include <algorithm>
 #include <optional>
 #include <ranges>
+#include <span>
 
 /* https://adventofcode.com/2016/day/17
  */
@@ -13,57 +15,237 @@ constexpr size_t DAY = 17;
 
 namespace
 {
-struct Path
+constexpr std::string_view DIR_LITERALS = "UDLR";
+constexpr std::array<std::pair<int, int>, 4> DIRS = {
+    {/*UP*/ {0, -1}, /*DOWN*/ {0, 1}, /*LEFT*/ {-1, 0}, /*RIGHT*/ {1, 0}}};
+
+// A room reached by some path.  Rather than the path itself it keeps MD5 over the whole blocks of
+// seed + path, and the path characters since then at 2 bits per block offset, which is all the
+// hash of seed + path needs.  The path's length is the same for everyone on a level.
+struct Walker
 {
-    int x{};
-    int y{};
-    std::string path;
+    std::array<uint32_t, 4> midstate{};
+    std::array<uint64_t, 2> tail{};
+    uint8_t x{};
+    uint8_t y{};
 };
 
-template <int GRID> StringSolution bfs(const std::string& seed)
+// how a walker was reached, kept per level only until the shortest path is known
+struct Step
 {
-    constexpr int MAX = GRID - 1;
-    constexpr std::array<std::pair<int, int>, 4> DIRS = {
-        {/*UP*/ {0, -1}, /*DOWN*/ {0, 1}, /*LEFT*/ {-1, 0}, /*RIGHT*/ {1, 0}}};
-    constexpr std::string_view DIR_LITERALS = "UDLR";
-    auto hasher = Hash::Hasher::md5Hasher();
-    std::deque<Path> horizon;
-    horizon.emplace_back();
-    std::optional<std::string> shortest;
-    size_t longest{};
-    while (horizon.size())
+    uint32_t parent;
+    uint8_t dir;
+};
+
+class Vault
+{
+    // levels at least this big are hashed across the pool
+    static constexpr size_t CHUNK = Hash::md5::LANES * 8;
+
+    std::string seed;
+
+    // byte `offset` of the block of seed + path starting at `start`
+    [[nodiscard]] uint8_t byteAt(const Walker& w, size_t start, size_t offset) const
+    {
+        if (start + offset < seed.size())
+        {
+            return static_cast<uint8_t>(seed[start + offset]);
+        }
+        auto bits = w.tail[offset / 32] >> (2 * (offset % 32)); // NOLINT(*-magic-numbers)
+        return static_cast<uint8_t>(DIR_LITERALS[bits & 3]);
+    }
+
+    // the block holding the last `bytes` bytes of seed + path, which is `size` long, padded when
+    // the message ends inside it
+    [[nodiscard]] Hash::md5::Block block(const Walker& w, size_t size, size_t bytes) const
     {
-        auto cur = horizon.front();
-        horizon.pop_front();
-        auto hash = hasher(seed + cur.path);
-        // NOLINTBEGIN (cppcoreguidelines-avoid-magic-numbers)
-        std::array<int, 4> locks = {hash[0] >> 4, hash[0] & 0x0F, hash[1] >> 4, hash[1] & 0x0F};
-        for (auto [dir, d, l] : std::views::zip(DIRS, DIR_LITERALS, locks) | std::views::reverse)
+        Hash::md5::Block m{};
+        auto put = [&m](size_t offset, uint32_t byte)
+        { m[offset / 4] |= byte << (8 * (offset % 4)); }; // NOLINT(*-magic-numbers)
+        for (size_t offset = 0; offset < bytes; ++offset)
+        {
+            put(offset, byteAt(w, size - bytes, offset));
+        }
+        if (bytes < Hash::md5::BLOCK_BYTES)
         {
-            if (l >= 0x0B)
+            put(bytes, 0x80); // NOLINT(*-magic-numbers)
+        }
+        if (bytes <= Hash::md5::MAX_TAIL)
+        {
+            lengthWords(m, size);
+        }
+        return m;
+    }
+
+    static void lengthWords(auto& m, size_t size)
+    {
+        uint64_t bits = uint64_t{size} * 8;
+        m[14] = m[14] + static_cast<uint32_t>(bits);       // NOLINT(*-magic-numbers)
+        m[15] = m[15] + static_cast<uint32_t>(bits >> 32); // NOLINT(*-magic-numbers)
+    }
+
+    // which doors of level[i] are open, as bits in DIRS order, for paths making seed + path `size`
+    void openDoors(std::span<const Walker> level, size_t size, std::span<uint8_t> doors) const
+    {
+        using Hash::md5::Lanes;
+        using Hash::md5::LANES;
+        auto bytes = size % Hash::md5::BLOCK_BYTES;
+        for (size_t base = 0; base < level.size(); base += LANES)
+        {
+            auto count = std::min(LANES, level.size() - base);
+            Hash::md5::State<Lanes> s;
+            std::array<Lanes, 16> m{};
+            for (size_t lane = 0; lane < count; ++lane)
             {
-                auto [dx, dy] = dir;
-                auto path = cur.path + d;
-                auto x = cur.x + dx;
-                auto y = cur.y + dy;
-                if (x == MAX && y == MAX)
+                const auto& w = level[base + lane];
+                for (size_t i = 0; i < s.h.size(); ++i)
                 {
-                    if (!shortest)
-                    {
-                        shortest = path;
-                    }
-                    longest = path.size();
+                    s.h[i][lane] = w.midstate[i];
                 }
-                else if (x >= 0 && x <= MAX && y >= 0 && y <= MAX)
+                auto last = block(w, size, bytes);
+                for (size_t i = 0; i < m.size(); ++i)
                 {
-                    horizon.emplace_back(x, y, path);
+                    m[i][lane] = last[i];
                 }
             }
+            s.compress(m);
+            if (bytes > Hash::md5::MAX_TAIL)
+            {
+                std::array<Lanes, 16> lengths{};
+                lengthWords(lengths, size);
+                s.compress(lengths);
+            }
+            // NOLINTBEGIN(*-magic-numbers)
+            for (size_t lane = 0; lane < count; ++lane)
+            {
+                auto h = s.h[0][lane];
+                std::array<uint32_t, 4> locks = {(h >> 4) & 0xF, h & 0xF, (h >> 12) & 0xF,
+                                                 (h >> 8) & 0xF};
+                uint8_t open{};
+                for (size_t d = 0; d < locks.size(); ++d)
+                {
+                    open |= static_cast<uint8_t>(locks[d] >= 0xB) << d;
+                }
+                doors[base + lane] = open;
+            }
+            // NOLINTEND(*-magic-numbers)
         }
-        // NOLINTEND
     }
-    return {*shortest, std::to_string(longest)};
-}
+
+    // w's path gains `dir` as byte `size` of seed + path
+    void append(Walker& w, size_t size, size_t dir) const
+    {
+        auto offset = size % Hash::md5::BLOCK_BYTES;
+        w.tail[offset / 32] |= uint64_t{dir} << (2 * (offset % 32)); // NOLINT(*-magic-numbers)
+        if (offset + 1 == Hash::md5::BLOCK_BYTES)
+        {
+            Hash::md5::State<uint32_t> s{w.midstate};
+            s.compress(block(w, size + 1, Hash::md5::BLOCK_BYTES));
+            w.midstate = s.h;
+            w.tail = {};
+        }
+    }
+
+  public:
+    explicit Vault(std::string seed) : seed{std::move(seed)} {}
+
+    template <int GRID> StringSolution search() const
+    {
+        constexpr int MAX = GRID - 1;
+        Walker start;
+        Hash::md5::State<uint32_t> s;
+        for (size_t b = 0; b < seed.size() / Hash::md5::BLOCK_BYTES; ++b)
+        {
+            s.compress(Hash::md5::paddedBlock(seed, b));
+        }
+        start.midstate = s.h;
+
+        std::vector<Walker> level{start};
+        std::vector<Walker> next;
+        std::vector<uint8_t> doors;
+        std::vector<std::vector<Step>> steps;
+        std::optional<std::string> shortest;
+        size_t longest{};
+        for (size_t depth = 0; !level.empty(); ++depth)
+        {
+            auto size = seed.size() + depth;
+            doors.resize(level.size());
+            {
+                TaskGroup group;
+                for (size_t base = CHUNK; base < level.size(); base += CHUNK)
+                {
+                    auto count = std::min(CHUNK, level.size() - base);
+                    group.run(
+                        [&, base, count]
+                        {
+                            openDoors(std::span{level}.subspan(base, count), size,
+                                      std::span{doors}.subspan(base, count));
+                        });
+                }
+                auto count = std::min(CHUNK, level.size());
+                openDoors(std::span{level}.first(count), size, std::span{doors}.first(count));
+                group.wait();
+            }
+
+            next.clear();
+            if (!shortest)
+            {
+                steps.emplace_back();
+            }
+            for (size_t i = 0; i < level.size(); ++i)
+            {
+                const auto& cur = level[i];
+                for (auto d : std::views::iota(0UZ, DIRS.size()) | std::views::reverse)
+                {
+                    if ((doors[i] >> d & 1) == 0)
+                    {
+                        continue;
+                    }
+                    auto x = cur.x + DIRS[d].first;
+                    auto y = cur.y + DIRS[d].second;
+                    if (x == MAX && y == MAX)
+                    {
+                        if (!shortest)
+                        {
+                            shortest = path(steps, i, d);
+                            steps = {};
+                        }
+                        longest = depth + 1;
+                    }
+                    else if (x >= 0 && x <= MAX && y >= 0 && y <= MAX)
+                    {
+                        auto& child = next.emplace_back(cur);
+                        child.x = static_cast<uint8_t>(x);
+                        child.y = static_cast<uint8_t>(y);
+                        append(child, size, d);
+                        if (!shortest)
+                        {
+                            steps.back().emplace_back(static_cast<uint32_t>(i),
+                                                      static_cast<uint8_t>(d));
+                        }
+                    }
+                }
+            }
+            std::swap(level, next);
+        }
+        return {shortest.value(), std::to_string(longest)};
+    }
+
+    // the path to walker `i` of the current level, then `dir`
+    static std::string path(const std::vector<std::vector<Step>>& steps, size_t i, size_t dir)
+    {
+        std::string path(1, DIR_LITERALS[dir]);
+        // steps.back() is for the level being built, the current level's steps come before it
+        for (auto depth = steps.size() - 1; depth-- > 0;)
+        {
+            const auto& step = steps[depth][i];
+            path += DIR_LITERALS[step.dir];
+            i = step.parent;
+        }
+        std::ranges::reverse(path);
+        return path;
+    }
+};
 } // namespace
 
 template <> struct SolutionType<YEAR, DAY>
@@ -75,6 +257,6 @@ template <> StringSolution solve<YEAR, DAY>(std::istream& input)
 {
     std::string seed;
     input >> seed;
-    return bfs<4>(seed);
+    return Vault{std::move(seed)}.search<4>();
 }
 } // namespace aoc
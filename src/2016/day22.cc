@@ -1,10 +1,13 @@
 #include "aoc.hh"
+#include "arena.hh"
 #include <algorithm>
 #include <cassert>
 #include <ctre.hpp>
+#include <memory_resource>
 #include <queue>
 #include <ranges>
 #include <set>
+#include <span>
 #include <utility>
 
 /* https://adventofcode.com/2016/day/22
@@ -56,7 +59,7 @@ auto canMove(const Node& from)
     { return from != to && from.used > 0 && to.cap - to.used >= from.used; };
 }
 
-auto countValid(const std::vector<Node>& nodes)
+auto countValid(std::span<const Node> nodes)
 {
     return std::ranges::fold_left(
         nodes | std::views::transform([&nodes](auto n)
@@ -129,17 +132,20 @@ std::pair<int, int> operator+(const std::pair<int, int>& l, const std::pair<int,
     return {l.first + r.first, l.second + r.second};
 }
 
-auto solveSlidingBlock(const std::vector<Node>& nodes)
+auto solveSlidingBlock(std::span<const Node> nodes)
 {
     auto empty = std::ranges::find_if(nodes, [](auto n) { return n.used == 0; });
     auto target = std::ranges::max(nodes | std::views::filter([](auto n) { return n.y == 0; }) |
                                    std::views::transform(&Node::x));
     auto space = empty->cap;
-    auto valid = std::ranges::to<std::set>(
-        nodes | std::views::filter([space](auto n) { return n.used <= space; }) |
-        std::views::transform([](auto n) { return std::make_pair(n.x, n.y); }));
-    std::set<PuzzleState> seen;
-    std::priority_queue<PuzzleSearch, std::vector<PuzzleSearch>, std::greater<>> horizon;
+    std::pmr::set<std::pair<int, int>> valid{arena()};
+    for (const auto& n : nodes | std::views::filter([space](auto n) { return n.used <= space; }))
+    {
+        valid.emplace(n.x, n.y);
+    }
+    std::pmr::set<PuzzleState> seen{arena()};
+    std::priority_queue<PuzzleSearch, std::pmr::vector<PuzzleSearch>, std::greater<>> horizon{
+        std::greater<>{}, std::pmr::vector<PuzzleSearch>{arena()}};
     PuzzleState start{.empty = {empty->x, empty->y}, .target = {target, 0}};
     seen.insert(start);
     horizon.emplace(start);
@@ -182,7 +188,7 @@ template <> Solution_t<YEAR, DAY> solve<YEAR, DAY>(std::istream& input)
     // 2 header lines
     std::getline(input, tmp);
     std::getline(input, tmp);
-    auto nodes = readAll<Node>(input);
+    auto nodes = readAll<Node>(input, arena());
     assert(input.eof());
     return {static_cast<int>(countValid(nodes)), solveSlidingBlock(nodes)};
 }
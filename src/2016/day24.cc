@@ -1,8 +1,10 @@
 #include "aoc.hh"
+#include "arena.hh"
 #include <algorithm>
 #include <cassert>
 #include <deque>
 #include <memory>
+#include <memory_resource>
 #include <ranges>
 #include <set>
 
@@ -80,8 +82,8 @@ template <> Solution_t<YEAR, DAY> solve<YEAR, DAY>(std::istream& input)
     std::ranges::sort(targets);
     const auto ptargets = std::make_shared<decltype(targets)>(std::move(targets));
 
-    auto seen = std::set<State<ssize_t, VisitSet<char>>>{};
-    auto horizon = std::deque<Path<ssize_t, VisitSet<char>>>{};
+    auto seen = std::pmr::set<State<ssize_t, VisitSet<char>>>{arena()};
+    auto horizon = std::pmr::deque<Path<ssize_t, VisitSet<char>>>{arena()};
 
     const auto initial = State{.loc = start, .visited = VisitSet{ptargets}.visit('0')};
     seen.insert(initial);
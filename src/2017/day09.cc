@@ -1,4 +1,5 @@
 #include "aoc.hh"
+#include "inputstream.hh"
 
 /* https://adventofcode.com/2017/day/9
  */
@@ -10,28 +11,35 @@ using Solution = Solution_t<YEAR, DAY>;
 
 namespace
 {
-auto removeGarbage(std::string_view dirty)
+// scores groups and counts garbage in the same pass, the state carries over between chunks
+struct Groups
 {
-    std::string res;
+    int score{};
+    int removed{};
+    int depth{};
     bool inGarbage{};
     bool skip{};
-    int removed{};
-    for (auto c : dirty)
+
+    void feed(std::string_view chunk)
     {
-        if (!inGarbage)
+        for (auto c : chunk)
         {
-            if (c != '<')
-            {
-                res.push_back(c);
-            }
-            else
+            if (!inGarbage)
             {
-                inGarbage = true;
+                if (c == '<')
+                {
+                    inGarbage = true;
+                }
+                else if (c == '{')
+                {
+                    score += ++depth;
+                }
+                else if (c == '}')
+                {
+                    --depth;
+                }
             }
-        }
-        else
-        {
-            if (skip)
+            else if (skip)
             {
                 skip = false;
             }
@@ -49,32 +57,18 @@ auto removeGarbage(std::string_view dirty)
             }
         }
     }
-    return std::make_pair(res, removed);
-}
+};
+} // namespace
 
-int score(std::string_view nested)
+template <> Solution solve<YEAR, DAY>(InputStream& input)
 {
-    int res{};
-    int depth{1};
-    for (auto c : nested)
-    {
-        if (c == '{')
-        {
-            ++depth;
-        }
-        else if (c == '}')
-        {
-            res += --depth;
-        }
-    }
-    return res;
+    auto groups = parseStream<Groups>(input);
+    return {groups.score, groups.removed};
 }
-} // namespace
+
 template <> Solution solve<YEAR, DAY>(std::istream& input)
 {
-    auto text = slurp(input);
-    auto [cleaned, removed] = removeGarbage(text);
-
-    return {score(cleaned), removed};
+    IstreamStream stream{input};
+    return solve<YEAR, DAY>(static_cast<InputStream&>(stream));
 }
 } // namespace aoc
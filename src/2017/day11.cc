@@ -1,7 +1,10 @@
 #include "aoc.hh"
-#include "util.hh"
+#include "inputstream.hh"
+#include <algorithm>
+#include <cctype>
 #include <map>
-#include <ranges>
+#include <stdexcept>
+#include <string>
 
 /* https://adventofcode.com/2017/day/11
  */
@@ -25,22 +28,6 @@ enum class Dir
 const std::map<std::string, Dir> lut = {{"n", Dir::N}, {"ne", Dir::NE}, {"se", Dir::SE},
                                         {"s", Dir::S}, {"sw", Dir::SW}, {"nw", Dir::NW}};
 
-auto parse(std::string_view text)
-{
-    return std::ranges::to<std::vector>(text | std::views::split(',') |
-                                        std::views::transform(
-                                            [](auto sv)
-                                            {
-                                                auto s = std::string{sv.begin(), sv.end()};
-                                                if (!lut.contains(s))
-                                                {
-                                                    throw std::invalid_argument(
-                                                        "Unknown direction: " + s);
-                                                }
-                                                return lut.at(s);
-                                            }));
-}
-
 auto hexhatten(auto sw, auto se)
 {
     // if signs are opposite, this is the best we can do
@@ -53,12 +40,16 @@ auto hexhatten(auto sw, auto se)
     return se > 0 ? std::max(sw, se) : sw - se;
 }
 
-auto solve(std::span<Dir> dirs)
+// The walk so far.  A direction can be split across chunks, so the unfinished one is kept in
+// `token` until its comma arrives.
+struct Walk
 {
-    auto farthest = int{};
-    auto sw = int{};
-    auto se = int{};
-    for (auto d : dirs)
+    int farthest{};
+    int sw{};
+    int se{};
+    std::string token;
+
+    void step(Dir d)
     {
         switch (d)
         {
@@ -85,13 +76,48 @@ auto solve(std::span<Dir> dirs)
         }
         farthest = std::max(farthest, hexhatten(sw, se));
     }
-    return Solution{hexhatten(sw, se), farthest};
-}
+
+    void finish()
+    {
+        if (token.empty())
+        {
+            return;
+        }
+        auto it = lut.find(token);
+        if (it == lut.end())
+        {
+            throw std::invalid_argument("Unknown direction: " + token);
+        }
+        step(it->second);
+        token.clear();
+    }
+
+    void feed(std::string_view chunk)
+    {
+        for (auto c : chunk)
+        {
+            if (c == ',')
+            {
+                finish();
+            }
+            else if (std::isspace(static_cast<unsigned char>(c)) == 0)
+            {
+                token.push_back(c);
+            }
+        }
+    }
+};
 } // namespace
 
+template <> Solution solve<YEAR, DAY>(InputStream& input)
+{
+    auto walk = parseStream<Walk>(input);
+    return {hexhatten(walk.sw, walk.se), walk.farthest};
+}
+
 template <> Solution solve<YEAR, DAY>(std::istream& input)
 {
-    auto dirs = parse(trim(slurp(input)));
-    return solve(dirs);
+    IstreamStream stream{input};
+    return solve<YEAR, DAY>(static_cast<InputStream&>(stream));
 }
 } // namespace aoc
@@ -1,7 +1,7 @@
 #include "aoc.hh"
 #include "util.hh"
 #include <cassert>
-#include <thread>
+#include <memory>
 
 /* https://adventofcode.com/2017/day/15
  */
@@ -46,11 +46,11 @@ template <Residue FAC> struct Generator
     }
 };
 
-void part1(Residue aSeed, Residue bSeed, int& out)
+int part1(Residue aSeed, Residue bSeed)
 {
     auto a = Generator<A_FAC>{aSeed};
     auto b = Generator<B_FAC>{bSeed};
-    out = 0;
+    int out = 0;
     for (int i{}; i < PART1_REPS; i += 1)
     {
         if (((a() ^ b()) & MASK) == 0)
@@ -58,17 +58,18 @@ void part1(Residue aSeed, Residue bSeed, int& out)
             ++out;
         }
     }
+    return out;
 }
 
 constexpr Residue A_MOD = 4;
 constexpr Residue B_MOD = 8;
 constexpr auto PART2_REPS = 5'000'000;
 
-void part2(Residue aSeed, Residue bSeed, int& out)
+int part2(Residue aSeed, Residue bSeed)
 {
     auto a = Generator<A_FAC>{aSeed};
     auto b = Generator<B_FAC>{bSeed};
-    out = 0;
+    int out = 0;
     for (int i{}; i < PART2_REPS; ++i)
     {
         Residue aRes{};
@@ -84,22 +85,36 @@ void part2(Residue aSeed, Residue bSeed, int& out)
             ++out;
         }
     }
+    return out;
 }
 } // namespace
 
-template <> Solution solve<YEAR, DAY>(std::istream& input)
+template <> struct Parsed<YEAR, DAY>
+{
+    Residue aSeed;
+    Residue bSeed;
+};
+
+template <> std::shared_ptr<const Parsed<YEAR, DAY>> parse<YEAR, DAY>(std::istream& input)
 {
     auto starts = readNumbers<Residue>(slurp(input));
     assert(starts.size() == 2);
-    auto aSeed = starts[0];
-    auto bSeed = starts[1];
-    int p1{};
-    int p2{};
-    // just because this one is longer than all preceding problems for the year
-    std::thread t1{part1, aSeed, bSeed, std::ref(p1)};
-    std::thread t2{part2, aSeed, bSeed, std::ref(p2)};
-    t1.join();
-    t2.join();
-    return {p1, p2};
+    return std::make_shared<const Parsed<YEAR, DAY>>(starts[0], starts[1]);
+}
+
+// the parts are independent and both long, the dispatcher runs them side by side
+template <> Part_t<YEAR, DAY> solvePart1<YEAR, DAY>(const Parsed<YEAR, DAY>& input)
+{
+    return part1(input.aSeed, input.bSeed);
+}
+
+template <> Part_t<YEAR, DAY> solvePart2<YEAR, DAY>(const Parsed<YEAR, DAY>& input)
+{
+    return part2(input.aSeed, input.bSeed);
+}
+
+template <> Solution solve<YEAR, DAY>(std::istream& input)
+{
+    return solveParts<YEAR, DAY>(input);
 }
 } // namespace aoc
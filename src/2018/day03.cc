@@ -1,6 +1,8 @@
 #include "aoc.hh"
+#include "input.hh"
 #include "util.hh"
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <format>
 #include <stdexcept>
@@ -35,8 +37,8 @@ Claim parse(std::string_view sv)
         HEIGHT,
         COUNT
     };
-    auto numbers = readNumbers(sv);
-    if (numbers.size() != COUNT)
+    std::array<int, COUNT + 1> numbers{};
+    if (scanNumbers<int>(sv, numbers) != COUNT)
     {
         throw std::invalid_argument(
             std::format("Malformed input, expected {} numbers {}", static_cast<int>(COUNT), sv));
@@ -45,10 +47,10 @@ Claim parse(std::string_view sv)
 }
 } // namespace
 
-template <> Solution solve<YEAR, DAY>(std::istream& input)
+template <> Solution solve<YEAR, DAY>(const InputView& input)
 {
     using namespace std::views;
-    auto claims = std::ranges::to<std::vector>(readAllLines(input) | transform(parse));
+    auto claims = std::ranges::to<std::vector>(input.lines() | transform(parse));
     auto width = std::ranges::max(claims | transform([](const auto& c) { return c.w + c.l; }));
     auto height = std::ranges::max(claims | transform([](const auto& c) { return c.h + c.t; }));
     auto top = std::ranges::min(claims | transform(&Claim::t));
@@ -96,4 +98,8 @@ template <> Solution solve<YEAR, DAY>(std::istream& input)
 
     return {static_cast<int>(part1), *part2};
 }
+template <> Solution solve<YEAR, DAY>(std::istream& input)
+{
+    return solve<YEAR, DAY>(InputView::fromStream(input));
+}
 } // namespace aoc
@@ -1,6 +1,8 @@
 #include "aoc.hh"
-#include "util.hh"
+#include "inputstream.hh"
 #include <algorithm>
+#include <cctype>
+#include <ranges>
 #include <set>
 
 /* https://adventofcode.com/2018/day/5
@@ -13,10 +15,12 @@ using Solution = Solution_t<YEAR, DAY>;
 
 namespace
 {
-auto part1(auto&& sequence)
+// Reacts units as they arrive; only the units that survive so far are kept
+struct Polymer
 {
-    auto reduced = std::string{};
-    for (const auto& c : sequence)
+    std::string reduced;
+
+    void react(char c)
     {
         if (reduced.empty() || c != (reduced.back() ^ 'A' ^ 'a'))
         {
@@ -27,11 +31,37 @@ auto part1(auto&& sequence)
             reduced.pop_back();
         }
     }
-    return std::ssize(reduced);
+
+    void feed(std::string_view chunk)
+    {
+        for (auto c : chunk)
+        {
+            if (std::isalpha(static_cast<unsigned char>(c)) != 0)
+            {
+                react(c);
+            }
+        }
+    }
+};
+
+auto part1(auto&& sequence)
+{
+    Polymer polymer;
+    for (char c : sequence)
+    {
+        polymer.react(c);
+    }
+    return std::ssize(polymer.reduced);
 }
 
+// Reactions never depend on other units, so removing a type before or after reducing the rest
+// ends the same: part 2 only needs to work over part 1's result
 auto part2(std::string_view sequence)
 {
+    if (sequence.empty())
+    {
+        return std::ptrdiff_t{};
+    }
     auto units = std::ranges::to<std::set>(
         sequence | std::views::transform([](auto c) { return std::tolower(c); }));
     auto without = [&sequence](auto c)
@@ -40,10 +70,15 @@ auto part2(std::string_view sequence)
 }
 } // namespace
 
+template <> Solution solve<YEAR, DAY>(InputStream& input)
+{
+    auto polymer = parseStream<Polymer>(input);
+    return {static_cast<int>(polymer.reduced.size()), static_cast<int>(part2(polymer.reduced))};
+}
+
 template <> Solution solve<YEAR, DAY>(std::istream& input)
 {
-    auto sequence = std::string{trim(slurp(input))};
-    return {static_cast<int>(part1(sequence)), static_cast<int>(part2(sequence))};
-    ;
+    IstreamStream stream{input};
+    return solve<YEAR, DAY>(static_cast<InputStream&>(stream));
 }
 } // namespace aoc
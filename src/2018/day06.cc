@@ -1,6 +1,8 @@
 #include "aoc.hh"
+#include "input.hh"
 #include "util.hh"
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <deque>
 #include <iostream>
@@ -18,8 +20,8 @@ namespace
 {
 auto parse(std::string_view text)
 {
-    auto numbers = readNumbers(text);
-    if (numbers.size() != 2)
+    std::array<int, 3> numbers{};
+    if (scanNumbers<int>(text, numbers) != 2)
     {
         throw std::invalid_argument(std::format("Malformed input, expected 2 numbers {}", text));
     }
@@ -129,9 +131,14 @@ auto part2(const auto& coords)
 }
 } // namespace
 
-template <> Solution solve<YEAR, DAY>(std::istream& input)
+template <> Solution solve<YEAR, DAY>(const InputView& input)
 {
-    auto coords = std::ranges::to<std::vector>(readAllLines(input) | std::views::transform(parse));
+    auto coords = std::ranges::to<std::vector>(input.lines() | std::views::transform(parse));
     return {part1(coords), part2(coords)};
 }
+
+template <> Solution solve<YEAR, DAY>(std::istream& input)
+{
+    return solve<YEAR, DAY>(InputView::fromStream(input));
+}
 } // namespace aoc
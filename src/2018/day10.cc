@@ -1,6 +1,8 @@
 #include "aoc.hh"
+#include "input.hh"
 #include "util.hh"
 #include <algorithm>
+#include <array>
 #include <limits>
 #include <ranges>
 #include <stdexcept>
@@ -22,8 +24,8 @@ namespace
 {
 auto parse(const auto& line)
 {
-    auto numbers = readNumbers(line);
-    if (numbers.size() != 4)
+    std::array<int, 5> numbers{};
+    if (scanNumbers<int>(line, numbers) != 4)
     {
         throw std::invalid_argument{"Malformed input"};
     }
@@ -92,10 +94,15 @@ auto simulate(auto particles)
 }
 } // namespace
 
-template <> Solution solve<YEAR, DAY>(std::istream& input)
+template <> Solution solve<YEAR, DAY>(const InputView& input)
 {
     auto particles = std::ranges::to<std::vector>(
-        readAllLines(input) | std::views::transform([](const auto& l) { return parse(l); }));
+        input.lines() | std::views::transform([](const auto& l) { return parse(l); }));
     return simulate(particles);
 }
+
+template <> Solution solve<YEAR, DAY>(std::istream& input)
+{
+    return solve<YEAR, DAY>(InputView::fromStream(input));
+}
 } // namespace aoc
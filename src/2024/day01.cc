@@ -22,14 +22,15 @@ constexpr size_t DAY = 1;
 
 template <> Solution_t<YEAR, DAY> solve<YEAR, DAY>(std::istream& input)
 {
-    int l{};
-    int r{};
+    auto numbers = readAll<int>(input);
     std::vector<int> left;
     std::vector<int> right;
-    while (input >> l >> r)
+    left.reserve(numbers.size() / 2);
+    right.reserve(numbers.size() / 2);
+    for (size_t i = 0; i + 1 < numbers.size(); i += 2)
     {
-        left.push_back(l);
-        right.push_back(r);
+        left.push_back(numbers[i]);
+        right.push_back(numbers[i + 1]);
     }
     std::ranges::sort(left);
     std::ranges::sort(right);
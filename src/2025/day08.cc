@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "aoc.hh"
+#include "phase.hh"
 namespace aoc
 {
 constexpr size_t YEAR = 2025;
@@ -89,21 +90,25 @@ ssize_t part1(const std::vector<std::string>& v, size_t connections)
 {
     std::vector<std::shared_ptr<Box>> boxes{};
     std::priority_queue<Wire> wires{};
-    for (const auto& in : v)
     {
-        ssize_t x = 0;
-        ssize_t y = 0;
-        ssize_t z = 0;
-        char c = 0;
-        std::istringstream ss{in};
-        ss >> x >> c >> y >> c >> z;
-        auto b = std::make_shared<Box>(x, y, z);
-        for (auto& o : boxes)
+        AOC_PHASE("build wires");
+        for (const auto& in : v)
         {
-            wires.emplace(o, b);
+            ssize_t x = 0;
+            ssize_t y = 0;
+            ssize_t z = 0;
+            char c = 0;
+            std::istringstream ss{in};
+            ss >> x >> c >> y >> c >> z;
+            auto b = std::make_shared<Box>(x, y, z);
+            for (auto& o : boxes)
+            {
+                wires.emplace(o, b);
+            }
+            boxes.push_back(b);
         }
-        boxes.push_back(b);
     }
+    AOC_PHASE("union-find");
     for (size_t i = 0; i < connections; i++)
     {
         Wire w;
@@ -137,21 +142,25 @@ ssize_t part2(const std::vector<std::string>& v)
 {
     std::vector<std::shared_ptr<Box>> boxes{};
     std::priority_queue<Wire> wires{};
-    for (const auto& in : v)
     {
-        ssize_t x = 0;
-        ssize_t y = 0;
-        ssize_t z = 0;
-        char c = 0;
-        std::istringstream ss{in};
-        ss >> x >> c >> y >> c >> z;
-        auto b = std::make_shared<Box>(x, y, z);
-        for (auto& o : boxes)
+        AOC_PHASE("build wires");
+        for (const auto& in : v)
         {
-            wires.emplace(o, b);
+            ssize_t x = 0;
+            ssize_t y = 0;
+            ssize_t z = 0;
+            char c = 0;
+            std::istringstream ss{in};
+            ss >> x >> c >> y >> c >> z;
+            auto b = std::make_shared<Box>(x, y, z);
+            for (auto& o : boxes)
+            {
+                wires.emplace(o, b);
+            }
+            boxes.push_back(b);
         }
-        boxes.push_back(b);
     }
+    AOC_PHASE("union-find");
     Wire w;
     while (boxes[0]->rep()->sz < std::ssize(boxes))
     {
@@ -170,11 +179,23 @@ ssize_t part2(const std::vector<std::string>& v)
 
 template <> SsizeSolution solve<YEAR, DAY>(std::istream& input)
 {
-    auto lines = readAllLines(input);
+    std::vector<std::string> lines;
+    {
+        AOC_PHASE("parse");
+        lines = readAllLines(input);
+    }
     constexpr size_t SAMPLE_CONNECTIONS = 10;
     constexpr size_t ACTUAL_CONNECTIONS = 1000;
-    return SsizeSolution{
-        part1(lines, lines.size() < ACTUAL_CONNECTIONS ? SAMPLE_CONNECTIONS : ACTUAL_CONNECTIONS),
-        part2(lines)};
+    SsizeSolution solution;
+    {
+        AOC_PHASE("part1");
+        solution.part1 = part1(lines, lines.size() < ACTUAL_CONNECTIONS ? SAMPLE_CONNECTIONS
+                                                                         : ACTUAL_CONNECTIONS);
+    }
+    {
+        AOC_PHASE("part2");
+        solution.part2 = part2(lines);
+    }
+    return solution;
 }
 } // namespace aoc
\ No newline at end of file
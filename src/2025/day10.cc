@@ -1,13 +1,13 @@
 #include <algorithm>
+#include <cstdint>
 #include <deque>
 #include <limits>
-#include <numeric>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
-#include "matrix.hh"
-#include "rational.hh"
+#include "ilp.hh"
 
 #include "aoc.hh"
 namespace aoc
@@ -16,29 +16,11 @@ constexpr size_t YEAR = 2025;
 constexpr size_t DAY = 10;
 namespace
 {
-using Q = Rational<int>;
-
 struct Problem
 {
     std::vector<bool> target;
     std::vector<std::vector<size_t>> moves;
     std::vector<int> joltages;
-    template <typename T> [[nodiscard]] Matrix<T> toMatrix() const
-    {
-        Matrix<T> m{joltages.size(), moves.size() + 1};
-        for (size_t r = 0; r < joltages.size(); r++)
-        {
-            m(r, m.cols() - 1) = static_cast<T>(joltages[r]);
-        }
-        for (size_t c = 0; c < moves.size(); c++)
-        {
-            for (size_t r : moves[c])
-            {
-                m(r, c) = 1;
-            }
-        }
-        return m;
-    }
 };
 
 std::vector<bool> readLights(std::istream& is)
@@ -163,125 +145,36 @@ ssize_t part1(std::vector<Problem>& v)
     }
     return accum;
 }
-template <typename T, typename Coeff, typename Col>
-auto reduceHelper(std::vector<Col>& cols, std::vector<Coeff>& coeffs, std::vector<T>& orig)
-{
-    auto cli = cols.begin();
-    auto cfi = coeffs.begin();
-    for (; cli != cols.end(); ++cli, ++cfi)
-    {
-        std::transform(cli->begin(), cli->end(), orig.begin(), orig.begin(),
-                       [cfi](auto cv, auto ov) { return ov - cv * (*cfi); });
-    }
-}
-
-template <typename T, typename Coeff, typename Col>
-auto nextCoeffs(std::vector<Col>& cols, std::vector<Coeff>& coeffs, std::vector<T>& orig)
+// presses of each button, each at most the smallest joltage it feeds, summing to the joltages
+ssize_t minPresses(const Problem& p)
 {
-    for (size_t idx = 0; idx < coeffs.size(); idx++)
+    ilp::Problem lp;
+    lp.cost.assign(p.moves.size(), 1);
+    lp.upper.assign(p.moves.size(), std::numeric_limits<int64_t>::max());
+    lp.rhs.assign(p.joltages.begin(), p.joltages.end());
+    lp.equalities.assign(p.joltages.size(), std::vector<int64_t>(p.moves.size()));
+    for (size_t c = 0; c < p.moves.size(); c++)
     {
-        coeffs[idx]++;
-        std::vector<T> test{orig};
-        reduceHelper(cols, coeffs, test);
-        if (std::all_of(test.begin(), test.end(), [](auto t) { return t >= 0; }))
+        for (size_t r : p.moves[c])
         {
-            return true;
+            lp.equalities[r][c] = 1;
+            lp.upper[c] = std::min<int64_t>(lp.upper[c], p.joltages[r]);
         }
-        coeffs[idx] = 0;
     }
-    return false;
-}
-
-template <typename T = Q> auto minPresses(Matrix<T>& m)
-{
-    int presses = std::numeric_limits<int>::max();
-    Matrix<T> orig{m};
-    // std::cout << m << std::endl;
-    m.rowReduce();
-    // std::cout << m << std::endl;
-    size_t lastPivot = -1;
-    size_t dim = std::min(m.rows(), m.cols() - 1);
-    for (size_t c = 0; c < dim; c++)
+    auto best = ilp::minimize(lp);
+    if (!best)
     {
-        if (m(c, c) == 1)
-        {
-            lastPivot = c;
-            continue;
-        }
-        for (size_t d = c + 1; d < m.cols() - 1; d++)
-        {
-            if (m(c, d) == 1)
-            {
-                m.swapColumns(c, d);
-                orig.swapColumns(c, d);
-                lastPivot = c;
-                break;
-            }
-        }
-    }
-    // std::cout << m << std::endl;
-    // std::cout << lastPivot << std::endl;
-
-    std::vector<int> freeCoeffs((m.cols() - lastPivot - 2), 0);
-    std::vector<typename Matrix<T>::Column> freeCols{};
-    std::vector<typename Matrix<T>::Column> origFreeCols{};
-
-    for (size_t c = lastPivot + 1; c < m.cols() - 1; c++)
-    {
-        freeCols.push_back(m.column(c));
-        origFreeCols.push_back(orig.column(c));
-    }
-
-    std::vector<typename Matrix<T>::Column> allCols{};
-
-    allCols.reserve(orig.cols() - 1);
-    for (size_t c = 0; c < orig.cols() - 1; c++)
-    {
-        allCols.push_back(orig.column(c));
-    };
-
-    auto origTargetCol = orig.column(orig.cols() - 1);
-    std::vector<T> origTarget{origTargetCol.begin(), origTargetCol.end()};
-    auto rrTargetCol = m.column(m.cols() - 1);
-    std::vector<T> rrTarget{rrTargetCol.begin(), rrTargetCol.end()};
-    for (;;)
-    {
-        std::vector<T> rrTest{rrTarget};
-        reduceHelper(freeCols, freeCoeffs, rrTest);
-        if (std::all_of(rrTest.begin(), rrTest.end(), [](auto t) { return t >= 0; }))
-        {
-            std::vector<int> allCoeffs{};
-            allCoeffs.reserve(m.cols() - 1);
-            for (size_t c = 0; c < m.cols() - 1; c++)
-            {
-                allCoeffs.push_back(
-                    static_cast<int>(c <= lastPivot ? rrTest[c] : freeCoeffs[c - lastPivot - 1]));
-            }
-            std::vector<T> origTest{origTarget};
-            reduceHelper(allCols, allCoeffs, origTest);
-            if (std::all_of(origTest.begin(), origTest.end(), [](auto t) { return t == 0; }))
-            {
-                presses = std::min(presses, std::accumulate(allCoeffs.begin(), allCoeffs.end(), 0));
-            }
-        }
-        if (!nextCoeffs(origFreeCols, freeCoeffs, origTarget))
-        {
-            break;
-        }
+        throw std::invalid_argument("Joltages can't be reached");
     }
-    // std::cout << presses << std::endl;
-    return presses;
+    return best->value;
 }
 
 ssize_t part2(std::vector<Problem>& v)
 {
     ssize_t accum{};
-    // int count = 0;
     for (auto& p : v)
     {
-        // std::cout << count++ << std::endl;
-        auto m = p.toMatrix<Q>();
-        accum += minPresses(m);
+        accum += minPresses(p);
     }
     return accum;
 }
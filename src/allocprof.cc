@@ -0,0 +1,156 @@
+#include "allocprof.hh"
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+/* Replacement global allocation functions that keep aoc::alloc::counters() up to date.  Sizes are
+ * taken from malloc_usable_size so that frees, which mostly arrive unsized, balance exactly.
+ */
+namespace
+{
+
+void recordAlloc(void* p)
+{
+    auto& c = aoc::alloc::counters();
+    auto size = static_cast<int64_t>(malloc_usable_size(p));
+    c.allocations.fetch_add(1, std::memory_order_relaxed);
+    c.bytes.fetch_add(static_cast<uint64_t>(size), std::memory_order_relaxed);
+    auto live = c.live.fetch_add(size, std::memory_order_relaxed) + size;
+    auto peak = c.peak.load(std::memory_order_relaxed);
+    while (live > peak && !c.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+    {
+    }
+}
+
+void recordFree(void* p)
+{
+    if (p != nullptr)
+    {
+        aoc::alloc::counters().live.fetch_sub(static_cast<int64_t>(malloc_usable_size(p)),
+                                              std::memory_order_relaxed);
+    }
+}
+
+void* allocate(std::size_t size, std::size_t align = 0)
+{
+    if (size == 0)
+    {
+        size = 1;
+    }
+    for (;;)
+    {
+        void* p = nullptr;
+        if (align <= alignof(std::max_align_t))
+        {
+            p = std::malloc(size); // NOLINT(cppcoreguidelines-no-malloc)
+        }
+        else if (posix_memalign(&p, align, size) != 0)
+        {
+            p = nullptr;
+        }
+        if (p != nullptr)
+        {
+            recordAlloc(p);
+            return p;
+        }
+        auto handler = std::get_new_handler();
+        if (handler == nullptr)
+        {
+            throw std::bad_alloc{};
+        }
+        handler();
+    }
+}
+
+void deallocate(void* p)
+{
+    recordFree(p);
+    std::free(p); // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+// flags the counters as live as soon as this object is linked in
+const bool INTERPOSED = [] { return aoc::alloc::counters().interposed = true; }();
+
+} // namespace
+
+// NOLINTBEGIN(misc-new-delete-overloads)
+void* operator new(std::size_t size)
+{
+    return allocate(size);
+}
+void* operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+void* operator new(std::size_t size, std::align_val_t align)
+{
+    return allocate(size, static_cast<std::size_t>(align));
+}
+void* operator new[](std::size_t size, std::align_val_t align)
+{
+    return allocate(size, static_cast<std::size_t>(align));
+}
+void* operator new(std::size_t size, const std::nothrow_t& /*unused*/) noexcept
+{
+    try
+    {
+        return allocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+void* operator new[](std::size_t size, const std::nothrow_t& /*unused*/) noexcept
+{
+    try
+    {
+        return allocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void operator delete(void* p) noexcept
+{
+    deallocate(p);
+}
+void operator delete[](void* p) noexcept
+{
+    deallocate(p);
+}
+void operator delete(void* p, std::size_t /*unused*/) noexcept
+{
+    deallocate(p);
+}
+void operator delete[](void* p, std::size_t /*unused*/) noexcept
+{
+    deallocate(p);
+}
+void operator delete(void* p, std::align_val_t /*unused*/) noexcept
+{
+    deallocate(p);
+}
+void operator delete[](void* p, std::align_val_t /*unused*/) noexcept
+{
+    deallocate(p);
+}
+void operator delete(void* p, std::size_t /*unused*/, std::align_val_t /*unused*/) noexcept
+{
+    deallocate(p);
+}
+void operator delete[](void* p, std::size_t /*unused*/, std::align_val_t /*unused*/) noexcept
+{
+    deallocate(p);
+}
+void operator delete(void* p, const std::nothrow_t& /*unused*/) noexcept
+{
+    deallocate(p);
+}
+void operator delete[](void* p, const std::nothrow_t& /*unused*/) noexcept
+{
+    deallocate(p);
+}
+// NOLINTEND(misc-new-delete-overloads)
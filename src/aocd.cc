@@ -0,0 +1,309 @@
+#include "dispatch.hh"
+#include "hash.hh"
+#include "threadpool.hh"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <list>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+/* aocd: keeps solvers warm behind a Unix domain socket so callers don't pay process startup, digest
+ * fetches and pool creation on every solve.
+ *
+ * Each connection carries any number of requests, answered in order.  A request is one JSON line
+ * followed by the raw input bytes:
+ *
+ *     {"year": 2016, "day": 5, "size": 9}\n
+ *     abbhdwsy\n
+ *
+ * and the reply is one JSON line, {"part1": ..., "part2": ..., "us": ...} or {"error": ...}, where
+ * "us" is the solve time alone.
+ */
+namespace
+{
+using json = nlohmann::ordered_json;
+
+std::atomic<bool> stopping{false};
+
+void onSignal(int /*unused*/)
+{
+    stopping = true;
+}
+
+std::filesystem::path defaultSocket()
+{
+    if (const char* runtime = std::getenv("XDG_RUNTIME_DIR"); runtime != nullptr) // NOLINT
+    {
+        return std::filesystem::path{runtime} / "aocd.sock";
+    }
+    return "/tmp/aocd.sock";
+}
+
+class Connection
+{
+    int fd;
+    std::string buffer;
+
+    // appends whatever the socket has to the buffer, false on EOF or error
+    bool fill()
+    {
+        constexpr size_t CHUNK = 1 << 16;
+        auto old = buffer.size();
+        buffer.resize(old + CHUNK);
+        ssize_t n{};
+        do
+        {
+            n = ::recv(fd, std::next(buffer.data(), static_cast<std::ptrdiff_t>(old)), CHUNK, 0);
+        } while (n < 0 && errno == EINTR);
+        buffer.resize(old + static_cast<size_t>(std::max(n, ssize_t{})));
+        return n > 0;
+    }
+
+  public:
+    explicit Connection(int fd) : fd{fd} {}
+    Connection(const Connection&) = delete;
+    Connection(Connection&&) = delete;
+    Connection& operator=(const Connection&) = delete;
+    Connection& operator=(Connection&&) = delete;
+    ~Connection()
+    {
+        ::close(fd);
+    }
+
+    std::optional<std::string> readLine()
+    {
+        size_t nl{};
+        while ((nl = buffer.find('\n')) == std::string::npos)
+        {
+            if (!fill())
+            {
+                return {};
+            }
+        }
+        auto line = buffer.substr(0, nl);
+        buffer.erase(0, nl + 1);
+        return line;
+    }
+
+    std::optional<std::string> readBytes(size_t size)
+    {
+        while (buffer.size() < size)
+        {
+            if (!fill())
+            {
+                return {};
+            }
+        }
+        auto bytes = buffer.substr(0, size);
+        buffer.erase(0, size);
+        return bytes;
+    }
+
+    bool write(std::string_view data)
+    {
+        while (!data.empty())
+        {
+            auto n = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (n <= 0)
+            {
+                return false;
+            }
+            data.remove_prefix(static_cast<size_t>(n));
+        }
+        return true;
+    }
+
+    void shutdown() const
+    {
+        ::shutdown(fd, SHUT_RDWR);
+    }
+};
+
+json handle(const json& header, const std::string& input)
+{
+    auto year = header.at("year").get<size_t>();
+    auto day = header.at("day").get<size_t>();
+    if (std::ranges::find(aoc::YEARS, year) == aoc::YEARS.end() || day < 1 ||
+        day > aoc::NUM_DAYS)
+    {
+        return {{"error", "no such day"}};
+    }
+    aoc::InputView view{input};
+    auto start = std::chrono::steady_clock::now();
+    auto [part1, part2] = aoc::runSolver(year, day, view);
+    auto elapsed =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+    return {{"part1", part1}, {"part2", part2}, {"us", elapsed.count()}};
+}
+
+void serve(Connection& conn)
+{
+    while (auto line = conn.readLine())
+    {
+        json reply;
+        auto header = json::parse(*line, nullptr, false);
+        if (!header.is_object() || !header.contains("size"))
+        {
+            // the stream can't be resynchronised after a bad header
+            conn.write(json{{"error", "bad request header"}}.dump() + "\n");
+            return;
+        }
+        // far beyond any puzzle or generated input, but stops a bad size from buffering unbounded
+        constexpr size_t MAX_REQUEST_BYTES = size_t{1} << 30;
+        const auto& size = header["size"];
+        if (!size.is_number_unsigned() || size.get<size_t>() > MAX_REQUEST_BYTES)
+        {
+            conn.write(json{{"error", "bad input size"}}.dump() + "\n");
+            return;
+        }
+        auto input = conn.readBytes(size.get<size_t>());
+        if (!input)
+        {
+            return;
+        }
+        try
+        {
+            reply = handle(header, *input);
+        }
+        catch (const std::exception& e)
+        {
+            reply = {{"error", e.what()}};
+        }
+        if (!conn.write(reply.dump() + "\n"))
+        {
+            return;
+        }
+    }
+}
+
+int usage(const char* argv0)
+{
+    std::cerr << "usage: " << argv0 << " [--socket PATH]\n";
+    return 2;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    auto socketPath = defaultSocket();
+    // NOLINTBEGIN(*-pointer-arithmetic)
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc)
+        {
+            socketPath = argv[++i];
+        }
+        else
+        {
+            return usage(argv[0]);
+        }
+    }
+    // NOLINTEND(*-pointer-arithmetic)
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (socketPath.native().size() >= sizeof(addr.sun_path))
+    {
+        std::cerr << "socket path too long: " << socketPath.string() << "\n";
+        return 1;
+    }
+    std::strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+    // a stale socket from a previous run would make bind fail, but anything else at the path is
+    // left alone
+    auto removeSocket = [&socketPath]
+    {
+        std::error_code ec;
+        if (std::filesystem::is_socket(socketPath, ec))
+        {
+            std::filesystem::remove(socketPath, ec);
+        }
+    };
+    removeSocket();
+    int listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listener < 0 || ::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(listener, SOMAXCONN) != 0)
+    {
+        std::cerr << "cannot listen on " << socketPath.string() << ": " << std::strerror(errno)
+                  << "\n";
+        return 1;
+    }
+
+    // warm up everything a first request would otherwise pay for
+    aoc::ThreadPool::shared();
+    Hash::Hasher::md5Hasher();
+    Hash::Hasher::sha256Hasher();
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    std::cerr << "aocd listening on " << socketPath.string() << "\n";
+
+    // one thread per connection: they spend most of their time blocked on the client, so they
+    // mustn't occupy pool workers.  Solvers still fan out onto the shared pool.
+    struct Client
+    {
+        Connection conn;
+        std::thread thread;
+        std::atomic<bool> done{false};
+        explicit Client(int fd) : conn{fd} {}
+    };
+    std::list<Client> clients;
+    constexpr int POLL_MS = 200;
+    while (!stopping)
+    {
+        // reap finished connections
+        std::erase_if(clients,
+                      [](Client& c)
+                      {
+                          if (!c.done)
+                          {
+                              return false;
+                          }
+                          c.thread.join();
+                          return true;
+                      });
+
+        pollfd pfd{listener, POLLIN, 0};
+        if (::poll(&pfd, 1, POLL_MS) <= 0)
+        {
+            continue;
+        }
+        int fd = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            continue;
+        }
+        auto& client = clients.emplace_back(fd);
+        client.thread = std::thread{[&client]
+                                    {
+                                        serve(client.conn);
+                                        client.done = true;
+                                    }};
+    }
+
+    for (auto& client : clients)
+    {
+        client.conn.shutdown();
+        client.thread.join();
+    }
+    ::close(listener);
+    removeSocket();
+}
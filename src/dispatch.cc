@@ -1,41 +1,153 @@
 #include "dispatch.hh"
+#include "arena.hh"
 #include "solutions.hh"
+#include "threadpool.hh"
 #include <array>
+#include <filesystem>
 #include <sstream>
+#include <stdexcept>
 #include <utility>
 
 namespace
 {
 
-using SolverFn = std::pair<std::string, std::string> (*)(std::istream&);
+using SolverFn = std::pair<std::string, std::string> (*)(const aoc::InputView&);
+using ParseFn = std::shared_ptr<const void> (*)(const aoc::InputView&);
+using PartFn = std::string (*)(const void*);
+using FileFn = std::pair<std::string, std::string> (*)(const std::filesystem::path&);
 
-constexpr size_t NUM_DAYS = 25;
+struct DayEntry
+{
+    SolverFn solve;
+    bool slow;
+    // only set for days with HasParts
+    ParseFn parse;
+    std::array<PartFn, 2> parts;
+    // only set for days with IsStreaming
+    FileFn solveFile;
+};
+
+using aoc::NUM_DAYS;
+
+template <typename T> std::string toString(const T& value)
+{
+    std::ostringstream oss;
+    oss << value;
+    return oss.str();
+}
+
+template <size_t Y, size_t D> std::shared_ptr<const void> doParse(const aoc::InputView& input)
+{
+    aoc::ViewStream is{input};
+    return aoc::parse<Y, D>(is);
+}
+
+template <size_t Y, size_t D, size_t P> std::string doPart(const void* parsed)
+{
+    const auto& in = *static_cast<const aoc::Parsed<Y, D>*>(parsed);
+    if constexpr (P == 1)
+    {
+        return toString(aoc::solvePart1<Y, D>(in));
+    }
+    else
+    {
+        return toString(aoc::solvePart2<Y, D>(in));
+    }
+}
+
+template <size_t Y, size_t D>
+std::pair<std::string, std::string> doSolve(const aoc::InputView& input)
+{
+    if constexpr (aoc::HasParts<Y, D>::value)
+    {
+        // part 2 goes to the pool while this thread does part 1, then helps until it's done
+        auto parsed = doParse<Y, D>(input);
+        std::string p2;
+        aoc::TaskGroup group;
+        group.run(
+            [&]
+            {
+                // the pool thread needs an arena of its own; the solve's isn't thread-safe
+                aoc::ArenaScope arena;
+                p2 = doPart<Y, D, 2>(parsed.get());
+            });
+        auto p1 = doPart<Y, D, 1>(parsed.get());
+        group.wait();
+        return {std::move(p1), std::move(p2)};
+    }
+    else if constexpr (aoc::IsStreaming<Y, D>::value)
+    {
+        aoc::MemoryStream stream{input.text()};
+        auto sol = aoc::solve<Y, D>(static_cast<aoc::InputStream&>(stream));
+        return {toString(sol.part1), toString(sol.part2)};
+    }
+    else
+    {
+        auto sol = aoc::solve<Y, D>(input);
+        return {toString(sol.part1), toString(sol.part2)};
+    }
+}
 
 template <size_t Y, size_t D>
-std::pair<std::string, std::string> doSolve(std::istream& is)
-{
-    auto sol = aoc::solve<Y, D>(is);
-    std::ostringstream p1;
-    std::ostringstream p2;
-    p1 << sol.part1;
-    p2 << sol.part2;
-    return {p1.str(), p2.str()};
+std::pair<std::string, std::string> doSolveFile(const std::filesystem::path& path)
+{
+    aoc::FileStream stream{path};
+    auto sol = aoc::solve<Y, D>(static_cast<aoc::InputStream&>(stream));
+    return {toString(sol.part1), toString(sol.part2)};
+}
+
+template <size_t Y, size_t D> DayEntry makeEntry()
+{
+    if constexpr (aoc::HasParts<Y, D>::value)
+    {
+        return {doSolve<Y, D>, aoc::IsSlow<Y, D>::value, doParse<Y, D>,
+                {doPart<Y, D, 1>, doPart<Y, D, 2>}, nullptr};
+    }
+    else if constexpr (aoc::IsStreaming<Y, D>::value)
+    {
+        return {doSolve<Y, D>, aoc::IsSlow<Y, D>::value, nullptr, {}, doSolveFile<Y, D>};
+    }
+    else
+    {
+        return {doSolve<Y, D>, aoc::IsSlow<Y, D>::value, nullptr, {}, nullptr};
+    }
 }
 
-// Pack expansion over Ds = 0..24 to produce [doSolve<Y,1>, ..., doSolve<Y,25>]
+// Pack expansion over Ds = 0..24 to produce [makeEntry<Y,1>(), ..., makeEntry<Y,25>()]
 template <size_t Y, size_t... Ds>
-std::array<SolverFn, sizeof...(Ds)> makeDayTable(std::index_sequence<Ds...> /*unused*/)
+std::array<DayEntry, sizeof...(Ds)> makeDayTable(std::index_sequence<Ds...> /*unused*/)
 {
-    return {doSolve<Y, Ds + 1>...};
+    return {makeEntry<Y, Ds + 1>()...};
 }
 
 template <size_t Y>
-const std::array<SolverFn, NUM_DAYS>& dayTable()
+const std::array<DayEntry, NUM_DAYS>& dayTable()
 {
     static const auto table = makeDayTable<Y>(std::make_index_sequence<NUM_DAYS>{});
     return table;
 }
 
+const DayEntry* findDay(size_t year, size_t day)
+{
+    if (day < 1 || day > NUM_DAYS)
+    {
+        return nullptr;
+    }
+
+    // NOLINTBEGIN
+    switch (year)
+    {
+    case 2015: return &dayTable<2015>()[day - 1];
+    case 2016: return &dayTable<2016>()[day - 1];
+    case 2017: return &dayTable<2017>()[day - 1];
+    case 2018: return &dayTable<2018>()[day - 1];
+    case 2024: return &dayTable<2024>()[day - 1];
+    case 2025: return &dayTable<2025>()[day - 1];
+    // NOLINTEND
+    default: return nullptr;
+    }
+}
+
 } // namespace
 
 namespace aoc
@@ -43,23 +155,61 @@ namespace aoc
 
 std::pair<std::string, std::string> runSolver(size_t year, size_t day, std::istream& input)
 {
-    if (day < 1 || day > NUM_DAYS)
+    return runSolver(year, day, InputView::fromStream(input));
+}
+
+std::pair<std::string, std::string> runSolver(size_t year, size_t day, const InputView& input)
+{
+    const auto* entry = findDay(year, day);
+    if (!entry)
     {
         return {"", ""};
     }
+    ArenaScope arena;
+    return entry->solve(input);
+}
 
-    // NOLINTBEGIN
-    switch (year)
+std::pair<std::string, std::string> runSolver(size_t year, size_t day,
+                                              const std::filesystem::path& path)
+{
+    const auto* entry = findDay(year, day);
+    if (!entry)
     {
-    case 2015: return dayTable<2015>()[day - 1](input);
-    case 2016: return dayTable<2016>()[day - 1](input);
-    case 2017: return dayTable<2017>()[day - 1](input);
-    case 2018: return dayTable<2018>()[day - 1](input);
-    case 2024: return dayTable<2024>()[day - 1](input);
-    case 2025: return dayTable<2025>()[day - 1](input);
-    // NOLINTEND
-    default: return {"", ""};
+        return {"", ""};
+    }
+    if (entry->solveFile)
+    {
+        ArenaScope arena;
+        return entry->solveFile(path);
+    }
+    return runSolver(year, day, InputView::open(path));
+}
+
+ParsedInput parseInput(size_t year, size_t day, const InputView& input)
+{
+    const auto* entry = findDay(year, day);
+    if (!entry || !entry->parse)
+    {
+        return {year, day, nullptr};
     }
+    return {year, day, entry->parse(input)};
+}
+
+std::string runPart(const ParsedInput& parsed, int part)
+{
+    const auto* entry = findDay(parsed.year, parsed.day);
+    if (!parsed || !entry || !entry->parse || (part != 1 && part != 2))
+    {
+        throw std::invalid_argument{"runPart: no such part"};
+    }
+    ArenaScope arena;
+    return entry->parts[static_cast<size_t>(part - 1)](parsed.data.get());
+}
+
+bool isSlow(size_t year, size_t day)
+{
+    const auto* entry = findDay(year, day);
+    return entry && entry->slow;
 }
 
 } // namespace aoc
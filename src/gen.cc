@@ -0,0 +1,100 @@
+#include "generators.hh"
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/* gen: writes a synthetic input for one day at a chosen scale.
+ *
+ *     gen --list
+ *     gen --day 2018/9 --scale 100000000 [--seed S] [--out PATH]
+ */
+namespace
+{
+int usage(const char* argv0)
+{
+    std::cerr << "usage: " << argv0 << " --list\n"
+              << "       " << argv0 << " --day Y/D [--scale N] [--seed S] [--out PATH]\n";
+    return 2;
+}
+
+void list()
+{
+    for (const auto& g : aoc::gen::generators())
+    {
+        std::cout << g.year << "/" << std::setfill('0') << std::setw(2) << g.day << "  "
+                  << std::setfill(' ') << std::left << std::setw(32) << g.description
+                  << std::right << " (puzzle scale " << g.puzzleScale << ")\n";
+    }
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t year = 0;
+    size_t day = 0;
+    size_t scale = 0;
+    uint64_t seed = 1;
+    std::string out;
+
+    // NOLINTBEGIN(*-pointer-arithmetic)
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--list")
+        {
+            list();
+            return 0;
+        }
+        if (arg == "--day" && i + 1 < argc)
+        {
+            std::string value = argv[++i];
+            auto slash = value.find('/');
+            if (slash == std::string::npos)
+            {
+                return usage(argv[0]);
+            }
+            year = std::stoul(value.substr(0, slash));
+            day = std::stoul(value.substr(slash + 1));
+        }
+        else if (arg == "--scale" && i + 1 < argc)
+        {
+            // accepts 1e8 as well as 100000000
+            scale = static_cast<size_t>(std::stod(argv[++i]));
+        }
+        else if (arg == "--seed" && i + 1 < argc)
+        {
+            seed = std::stoull(argv[++i]);
+        }
+        else if (arg == "--out" && i + 1 < argc)
+        {
+            out = argv[++i];
+        }
+        else
+        {
+            return usage(argv[0]);
+        }
+    }
+    // NOLINTEND(*-pointer-arithmetic)
+
+    const auto* gen = aoc::gen::findGenerator(year, day);
+    if (gen == nullptr)
+    {
+        std::cerr << "no generator for " << year << "/" << day << ", see --list\n";
+        return 1;
+    }
+    if (scale == 0)
+    {
+        scale = gen->puzzleScale;
+    }
+
+    if (out.empty())
+    {
+        std::ios::sync_with_stdio(false);
+        gen->write(std::cout, scale, seed);
+        return 0;
+    }
+    std::ofstream ofs{out, std::ios::binary};
+    gen->write(ofs, scale, seed);
+    return ofs ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+#include "generators.hh"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace aoc::gen
+{
+namespace
+{
+using Rng = std::mt19937_64;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+
+// 2016/20: "low-high" blacklist ranges over the 32 bit addresses.  Range lengths average twice
+// the address space over n, so the blacklist overlaps heavily but still leaves gaps.
+void ipRanges(std::ostream& os, size_t n, uint64_t seed)
+{
+    Rng rng{seed};
+    constexpr uint64_t SPACE = uint64_t{std::numeric_limits<uint32_t>::max()} + 1;
+    auto meanLength = std::max<uint64_t>(SPACE * 2 / std::max<size_t>(n, 1), 1);
+    std::uniform_int_distribution<uint64_t> start{0, SPACE - 1};
+    std::uniform_int_distribution<uint64_t> length{0, meanLength * 2};
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto low = start(rng);
+        auto high = std::min(low + length(rng), SPACE - 1);
+        os << low << "-" << high << "\n";
+    }
+}
+
+// 2018/5: a polymer of n units.  Units are pushed onto a stack and, about half the time, the
+// opposite polarity of the top is emitted instead, so reactions nest as they do in real inputs.
+void polymer(std::ostream& os, size_t n, uint64_t seed)
+{
+    Rng rng{seed};
+    std::uniform_int_distribution<int> unit{0, 51};
+    std::bernoulli_distribution react{0.45};
+    std::vector<char> open;
+    std::string buf;
+    constexpr size_t FLUSH = 1 << 16;
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (!open.empty() && react(rng))
+        {
+            buf += static_cast<char>(open.back() ^ ('a' ^ 'A'));
+            open.pop_back();
+        }
+        else
+        {
+            auto u = unit(rng);
+            auto c = static_cast<char>(u < 26 ? 'a' + u : 'A' + (u - 26));
+            open.push_back(c);
+            buf += c;
+        }
+        if (buf.size() >= FLUSH)
+        {
+            os << buf;
+            buf.clear();
+        }
+    }
+    os << buf << "\n";
+}
+
+// 2018/9: n is the last marble of part 1 (part 2 plays 100 times as many)
+void marbles(std::ostream& os, size_t n, uint64_t seed)
+{
+    Rng rng{seed};
+    std::uniform_int_distribution<int> players{9, 500};
+    os << players(rng) << " players; last marble is worth " << n << " points\n";
+}
+
+// 2024/1: n lines of two 5 digit location ids
+void locationLists(std::ostream& os, size_t n, uint64_t seed)
+{
+    Rng rng{seed};
+    std::uniform_int_distribution<int> id{10000, 99999};
+    for (size_t i = 0; i < n; ++i)
+    {
+        os << id(rng) << "   " << id(rng) << "\n";
+    }
+}
+
+// 2025/8: n junction boxes "x,y,z" in a 10^5 cube
+void junctionBoxes(std::ostream& os, size_t n, uint64_t seed)
+{
+    Rng rng{seed};
+    std::uniform_int_distribution<int> coord{0, 99999};
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto x = coord(rng);
+        auto y = coord(rng);
+        auto z = coord(rng);
+        os << x << "," << y << "," << z << "\n";
+    }
+}
+
+constexpr std::array GENERATORS = {
+    Generator{2016, 20, "blacklisted address ranges", 1'000, ipRanges},
+    Generator{2018, 5, "polymer units (bytes)", 50'000, polymer},
+    Generator{2018, 9, "marbles in part 1", 70'000, marbles},
+    Generator{2024, 1, "pairs of location ids", 1'000, locationLists},
+    Generator{2025, 8, "junction boxes", 1'000, junctionBoxes},
+};
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
+} // namespace
+
+std::span<const Generator> generators()
+{
+    return GENERATORS;
+}
+
+const Generator* findGenerator(size_t year, size_t day)
+{
+    auto it = std::ranges::find_if(GENERATORS, [&](const Generator& g)
+                                   { return g.year == year && g.day == day; });
+    return it == GENERATORS.end() ? nullptr : &*it;
+}
+
+} // namespace aoc::gen
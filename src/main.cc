@@ -1,73 +1,919 @@
-#include "solutions.hh"
+#include "allocprof.hh"
+#include "bench.hh"
+#include "dispatch.hh"
+#include "generators.hh"
+#include "isolate.hh"
+#include "perfcounters.hh"
+#include "phase.hh"
+#include "resultcache.hh"
+#include "threadpool.hh"
+#include <algorithm>
+#include <charconv>
 #include <chrono>
+#include <cmath>
 #include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <optional>
 #include <sstream>
+#include <string_view>
+#include <vector>
 
 namespace
 {
-template <size_t Y, size_t D> void printSolution(bool useSample, bool includeSlow)
+using json = nlohmann::ordered_json;
+
+struct BenchContext
+{
+    aoc::bench::Options opts;
+    // 1 or 2 to time a single part of days that split their parts, 0 for the whole solve
+    int part = 0;
+    std::string reportPath = "bench.json";
+    json report = json::array();
+    // Chrome trace-event output, written only when a path is given
+    std::string tracePath;
+    json traceEvents = json::array();
+    std::optional<aoc::phase::Clock::time_point> traceEpoch;
+    // opened once for the whole run when --counters is given
+    std::optional<aoc::perf::Counters> counters;
+};
+
+struct RunOptions
+{
+    bool includeSlow = false;
+    // solve each day in a forked child, killed once it runs past the timeout
+    bool isolate = true;
+    std::optional<std::chrono::milliseconds> timeout = std::chrono::seconds{120}; // NOLINT
+    // reuse answers from cache.json while the day's object code and input are unchanged
+    std::optional<aoc::cache::ResultCache> cache;
+};
+
+struct Selection
+{
+    size_t year;
+    size_t day;
+    std::filesystem::path input;
+};
+
+std::filesystem::path inputPath(size_t year, size_t day, bool useSample)
+{
+    std::ostringstream oss{};
+    oss << "inputs/" << year << "/" << (useSample ? "sample" : "input") << std::setfill('0')
+        << std::setw(2) << day;
+    return oss.str();
+}
+
+std::ostream& dayLabel(std::ostream& os, size_t year, size_t day)
+{
+    return os << year << " Day " << std::setfill('0') << std::setw(2) << day;
+}
+
+void printUnsolved(const Selection& sel, const std::string& status, const std::string& why)
 {
-    if constexpr (aoc::IsSlow<Y, D>::value)
+    // NOLINTBEGIN
+    dayLabel(std::cout, sel.year, sel.day)
+        << " part 1: " << std::setfill(' ') << std::setw(18) << status << "\t"
+        << " part 2: " << std::setfill(' ') << std::setw(18) << status << "\t" << " (" << why
+        << ")\n";
+    // NOLINTEND
+}
+
+bool skipSlow(const Selection& sel, bool includeSlow)
+{
+    if (includeSlow || !aoc::isSlow(sel.year, sel.day))
     {
-        if (!includeSlow)
+        return false;
+    }
+    printUnsolved(sel, "SKIP", "slow");
+    return true;
+}
+
+void printAllocs(const aoc::alloc::Stats& stats)
+{
+    std::cout << ", " << stats.allocations << " allocs, " << stats.bytes << " B, peak "
+              << stats.peakBytes << " B";
+}
+
+// allocation counts barely vary run to run; the median run by count stands for them all
+std::optional<aoc::alloc::Stats> typicalAllocs(std::vector<aoc::alloc::Stats> runs)
+{
+    if (!aoc::alloc::enabled() || runs.empty())
+    {
+        return {};
+    }
+    std::ranges::sort(runs, {}, &aoc::alloc::Stats::allocations);
+    return runs[runs.size() / 2];
+}
+
+json allocsJson(const std::optional<aoc::alloc::Stats>& stats)
+{
+    if (!stats)
+    {
+        return nullptr;
+    }
+    return {{"allocations", stats->allocations},
+            {"bytes", stats->bytes},
+            {"peak_bytes", stats->peakBytes}};
+}
+
+aoc::InputView openInput(const std::filesystem::path& path)
+{
+    return std::filesystem::is_regular_file(path) ? aoc::InputView::open(path)
+                                                  : aoc::InputView{std::string_view{}};
+}
+
+struct Solved
+{
+    std::string part1;
+    std::string part2;
+    std::chrono::microseconds duration{};
+    aoc::alloc::Stats allocs;
+};
+
+Solved solveDay(const Selection& sel)
+{
+    // streaming days read the file while they solve, so opening it is inside the clock for all
+    bool haveFile = std::filesystem::is_regular_file(sel.input);
+
+    aoc::alloc::Scope allocs;
+    auto start = std::chrono::high_resolution_clock::now();
+    auto [part1, part2] = haveFile ? aoc::runSolver(sel.year, sel.day, sel.input)
+                                   : aoc::runSolver(sel.year, sel.day, openInput(sel.input));
+    auto end = std::chrono::high_resolution_clock::now();
+    auto allocStats = allocs.stop();
+    return {std::move(part1), std::move(part2),
+            std::chrono::duration_cast<std::chrono::microseconds>(end - start), allocStats};
+}
+
+// The same solve in a child process, fields passed back as text
+std::optional<Solved> solveIsolated(const Selection& sel, const RunOptions& opts,
+                                    long& peakRssKb)
+{
+    auto run = aoc::isolate::run(
+        [&]
+        {
+            auto s = solveDay(sel);
+            return aoc::isolate::pack({s.part1, s.part2, std::to_string(s.duration.count()),
+                                       std::to_string(s.allocs.allocations),
+                                       std::to_string(s.allocs.bytes),
+                                       std::to_string(s.allocs.peakBytes)});
+        },
+        opts.timeout);
+    peakRssKb = run.peakRssKb;
+    auto fields = aoc::isolate::unpack(run.output);
+    constexpr size_t FIELDS = 6;
+    if (run.status != aoc::isolate::Status::OK || fields.size() != FIELDS)
+    {
+        printUnsolved(sel, run.status == aoc::isolate::Status::TIMEOUT ? "TIMEOUT" : "FAIL",
+                      aoc::isolate::describe(run));
+        return {};
+    }
+    return Solved{std::move(fields[0]), std::move(fields[1]),
+                  std::chrono::microseconds{std::stoll(fields[2])},
+                  {std::stoull(fields[3]), std::stoull(fields[4]), std::stoull(fields[5])}};
+}
+
+void printSolution(const Selection& sel, RunOptions& opts)
+{
+    if (skipSlow(sel, opts.includeSlow))
+    {
+        return;
+    }
+
+    std::string cacheKey;
+    if (opts.cache && std::filesystem::is_regular_file(sel.input))
+    {
+        cacheKey = aoc::cache::key(sel.year, sel.day, openInput(sel.input).text());
+        if (auto hit = opts.cache->find(sel.year, sel.day, cacheKey))
         {
             // NOLINTBEGIN
-            std::cout << Y << " Day " << std::setfill('0') << std::setw(2) << D
-                      << " part 1: " << std::setfill(' ') << std::setw(18) << "SKIP" << "\t"
-                      << " part 2: " << std::setfill(' ') << std::setw(18) << "SKIP" << "\t"
-                      << " (slow)\n";
+            dayLabel(std::cout, sel.year, sel.day)
+                << " part 1: " << std::setfill(' ') << std::setw(18) << hit->part1 << "\t"
+                << " part 2: " << std::setfill(' ') << std::setw(18) << hit->part2 << "\t"
+                << " (cached, " << hit->duration.count() << " μs)\n";
             // NOLINTEND
             return;
         }
     }
 
-    std::ostringstream oss{};
-    oss << "inputs/" << Y << "/" << (useSample ? "sample" : "input") << std::setfill('0')
-        << std::setw(2) << D;
-    std::ifstream ifs{oss.str()};
+    std::optional<long> peakRssKb;
+    std::optional<Solved> solved;
+    if (opts.isolate)
+    {
+        solved = solveIsolated(sel, opts, peakRssKb.emplace());
+    }
+    else
+    {
+        solved = solveDay(sel);
+    }
+    if (!solved)
+    {
+        return;
+    }
+    if (!cacheKey.empty())
+    {
+        opts.cache->store(sel.year, sel.day, cacheKey,
+                          {solved->part1, solved->part2, solved->duration});
+    }
 
-    auto start = std::chrono::high_resolution_clock::now();
-    auto solution = aoc::solve<Y, D>(ifs);
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    // NOLINTBEGIN
+    dayLabel(std::cout, sel.year, sel.day)
+        << " part 1: " << std::setfill(' ') << std::setw(18) << solved->part1 << "\t"
+        << " part 2: " << std::setfill(' ') << std::setw(18) << solved->part2 << "\t" << " ("
+        << solved->duration.count() << " μs";
+    // NOLINTEND
+    if (aoc::alloc::enabled())
+    {
+        printAllocs(solved->allocs);
+    }
+    if (peakRssKb)
+    {
+        std::cout << ", " << *peakRssKb << " kB max RSS";
+    }
+    std::cout << ")\n";
+}
+
+// Per phase path, the summary of its total time in each run, in order of first appearance
+json summarizePhases(const std::vector<std::vector<aoc::phase::Record>>& runs)
+{
+    std::vector<std::string> order;
+    std::map<std::string, std::pair<size_t, std::vector<double>>> perPath;
+    for (size_t run = 0; run < runs.size(); ++run)
+    {
+        for (const auto& rec : runs[run])
+        {
+            auto [it, fresh] = perPath.try_emplace(rec.path, rec.depth, std::vector<double>{});
+            if (fresh)
+            {
+                order.push_back(rec.path);
+            }
+            auto& totals = it->second.second;
+            totals.resize(runs.size());
+            totals[run] += std::chrono::duration<double, std::micro>(rec.duration).count();
+        }
+    }
+    json phases = json::array();
+    for (const auto& path : order)
+    {
+        const auto& [depth, totals] = perPath.at(path);
+        auto s = aoc::bench::summarize(totals);
+        phases.push_back({{"path", path},
+                          {"depth", depth},
+                          {"min_us", s.min},
+                          {"median_us", s.median},
+                          {"p95_us", s.p95},
+                          {"stddev_us", s.stddev}});
+    }
+    return phases;
+}
+
+void addTraceEvents(BenchContext& ctx, const Selection& sel,
+                    const std::vector<std::vector<aoc::phase::Record>>& runs)
+{
+    for (const auto& run : runs)
+    {
+        for (const auto& rec : run)
+        {
+            if (!ctx.traceEpoch)
+            {
+                ctx.traceEpoch = rec.start;
+            }
+            std::ostringstream label;
+            dayLabel(label, sel.year, sel.day);
+            ctx.traceEvents.push_back(
+                {{"name", rec.path.substr(rec.path.rfind('/') + 1)},
+                 {"cat", label.str()},
+                 {"ph", "X"},
+                 {"ts", std::chrono::duration<double, std::micro>(rec.start - *ctx.traceEpoch)
+                            .count()},
+                 {"dur", std::chrono::duration<double, std::micro>(rec.duration).count()},
+                 {"pid", sel.year},
+                 {"tid", sel.day},
+                 {"args", {{"path", rec.path}}}});
+        }
+    }
+}
+
+aoc::perf::Sample sumCounts(const std::vector<aoc::perf::Sample>& counts)
+{
+    aoc::perf::Sample total;
+    for (const auto& c : counts)
+    {
+        for (size_t e = 0; e < aoc::perf::EVENT_COUNT; ++e)
+        {
+            if (c.values[e])
+            {
+                total.values[e] = total.values[e].value_or(0) + *c.values[e];
+            }
+        }
+    }
+    return total;
+}
+
+void printCounters(const aoc::perf::Sample& total)
+{
+    auto show = [](std::string_view label, std::optional<double> v, double scale,
+                   std::string_view unit)
+    {
+        std::cout << "  " << label << " ";
+        if (v)
+        {
+            std::cout << std::fixed << std::setprecision(2) << *v * scale << unit;
+        }
+        else
+        {
+            std::cout << "n/a";
+        }
+    };
+    constexpr double PERCENT = 100;
+    std::cout << std::string(9, ' '); // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+    show("ipc", total.ipc(), 1, "");
+    show("branch-miss", total.branchMissRate(), PERCENT, "%");
+    show("L1D-miss", total.l1dMissRate(), PERCENT, "%");
+    show("LLC-miss", total.llcMissRate(), PERCENT, "%");
+    std::cout << "\n";
+}
+
+json countersJson(const aoc::perf::Sample& total, size_t runs)
+{
+    auto opt = [](std::optional<double> v) { return v ? json(*v) : json(nullptr); };
+    json j = json::object();
+    for (size_t e = 0; e < aoc::perf::EVENT_COUNT; ++e)
+    {
+        // per run, so the numbers are comparable whatever --reps was
+        j[std::string{aoc::perf::EVENT_NAMES[e]}] =
+            total.values[e] && runs > 0 ? json(*total.values[e] / static_cast<double>(runs))
+                                        : json(nullptr);
+    }
+    j["ipc"] = opt(total.ipc());
+    j["branch_miss_rate"] = opt(total.branchMissRate());
+    j["l1d_miss_rate"] = opt(total.l1dMissRate());
+    j["llc_miss_rate"] = opt(total.llcMissRate());
+    return j;
+}
+
+// Runs the day repeatedly against one in-memory copy of its input, so file I/O stays out of the
+// measurement.  `scale` labels generated inputs.  Returns the median.
+double benchInput(const Selection& sel, const aoc::InputView& file, BenchContext& ctx,
+                  std::optional<size_t> scale = {})
+{
+    // a single part is timed against one shared parse, outside the clock
+    aoc::ParsedInput parsed;
+    if (ctx.part != 0)
+    {
+        parsed = aoc::parseInput(sel.year, sel.day, file);
+        if (!parsed)
+        {
+            dayLabel(std::cerr, sel.year, sel.day)
+                << ": no separate parts, timing the whole solve\n";
+        }
+    }
+
+    // a fresh borrowed view per run, so a lazily built line index is rebuilt and measured each time
+    std::pair<std::string, std::string> solution;
+    std::optional<aoc::InputView> input;
+    aoc::phase::Recorder recorder;
+    std::vector<std::vector<aoc::phase::Record>> runs;
+    std::vector<aoc::perf::Sample> counts;
+    std::vector<aoc::alloc::Stats> allocs;
+    std::optional<aoc::alloc::Scope> allocScope;
+    std::optional<aoc::phase::Scope> root;
+    // what the last run measured, kept by the timed call and filed away outside it
+    aoc::alloc::Stats allocated;
+    aoc::perf::Sample counted;
+    auto collect = [&]
+    {
+        allocs.push_back(allocated);
+        runs.push_back(recorder.take());
+        if (ctx.counters)
+        {
+            counts.push_back(counted);
+        }
+    };
+    auto samples = aoc::bench::measure(
+        ctx.opts,
+        [&]
+        {
+            if (!recorder.records().empty())
+            {
+                collect();
+            }
+            input.emplace(file.text());
+            // the root phase allocates its record, so it opens before anything is counted
+            root.emplace("solve");
+            // last things before the timed call, so only the solve itself is counted
+            allocScope.emplace();
+            if (ctx.counters)
+            {
+                ctx.counters->start();
+            }
+        },
+        [&]
+        {
+            if (!parsed)
+            {
+                solution = aoc::runSolver(sel.year, sel.day, *input);
+            }
+            else if (ctx.part == 1)
+            {
+                solution.first = aoc::runPart(parsed, 1);
+            }
+            else
+            {
+                solution.second = aoc::runPart(parsed, 2);
+            }
+            root.reset();
+            if (ctx.counters)
+            {
+                counted = ctx.counters->stop();
+            }
+            allocated = allocScope->stop();
+        });
+    collect();
+    // warmup runs don't count
+    auto dropWarmup = [&ctx](auto& v)
+    {
+        v.erase(v.begin(), std::next(v.begin(), static_cast<std::ptrdiff_t>(
+                                                    std::min(ctx.opts.warmup, v.size()))));
+    };
+    dropWarmup(runs);
+    dropWarmup(counts);
+    dropWarmup(allocs);
+    auto s = aoc::bench::summarize(samples);
+
+    // NOLINTBEGIN
+    dayLabel(std::cout, sel.year, sel.day)
+        << std::fixed << std::setprecision(1) << std::setfill(' ') << "  min " << std::setw(10)
+        << s.min << "  median " << std::setw(10) << s.median << "  p95 " << std::setw(10) << s.p95
+        << "  stddev " << std::setw(9) << s.stddev << " μs  (n=" << s.samples;
+    // NOLINTEND
+    if (scale)
+    {
+        std::cout << ", scale " << *scale;
+    }
+    auto allocStats = typicalAllocs(std::move(allocs));
+    if (allocStats)
+    {
+        printAllocs(*allocStats);
+    }
+    if (parsed)
+    {
+        std::cout << ", part " << ctx.part << " only";
+    }
+    std::cout << ")\n";
+
+    auto phases = summarizePhases(runs);
+    for (const auto& phase : phases)
+    {
+        const auto& path = phase["path"].get_ref<const std::string&>();
+        if (path == "solve")
+        {
+            continue;
+        }
+        // NOLINTBEGIN
+        auto depth = phase["depth"].get<size_t>();
+        auto name = path.substr(path.rfind('/') + 1);
+        depth = std::min(depth, 8UZ);
+        std::cout << std::string(2 * depth + 9, ' ') << std::left
+                  << std::setw(static_cast<int>(24 - 2 * depth))
+                  << name << std::right << "  median " << std::setw(10)
+                  << phase["median_us"].get<double>() << " μs\n";
+        // NOLINTEND
+    }
+    if (!ctx.tracePath.empty())
+    {
+        addTraceEvents(ctx, sel, runs);
+    }
+    json counters = nullptr;
+    if (ctx.counters)
+    {
+        auto total = sumCounts(counts);
+        printCounters(total);
+        counters = countersJson(total, counts.size());
+    }
+
+    ctx.report.push_back({{"year", sel.year},
+                          {"day", sel.day},
+                          {"scale", scale ? json(*scale) : json(nullptr)},
+                          {"part1", solution.first},
+                          {"part2", solution.second},
+                          {"part", parsed ? json(ctx.part) : json(nullptr)},
+                          {"warmup", ctx.opts.warmup},
+                          {"reps", s.samples},
+                          {"min_us", s.min},
+                          {"median_us", s.median},
+                          {"p95_us", s.p95},
+                          {"mean_us", s.mean},
+                          {"stddev_us", s.stddev},
+                          {"samples_us", samples},
+                          {"phases", phases},
+                          {"counters", counters},
+                          {"allocations", allocsJson(allocStats)}});
+    return s.median;
+}
+
+void benchSolution(const Selection& sel, bool includeSlow, BenchContext& ctx)
+{
+    if (skipSlow(sel, includeSlow))
+    {
+        return;
+    }
+
+    if (!std::filesystem::is_regular_file(sel.input))
+    {
+        return;
+    }
+    benchInput(sel, aoc::InputView::open(sel.input), ctx);
+}
+
+// Benchmarks the day on generated inputs at each scale, then prints how time grows with n: the
+// exponent is the slope of log(time) against log(n) from the previous scale
+int benchSweep(const Selection& sel, const std::vector<size_t>& scales, uint64_t seed,
+               BenchContext& ctx)
+{
+    const auto* gen = aoc::gen::findGenerator(sel.year, sel.day);
+    if (gen == nullptr)
+    {
+        dayLabel(std::cerr, sel.year, sel.day) << ": no input generator\n";
+        return 1;
+    }
+    std::vector<std::pair<size_t, double>> medians;
+    for (auto n : scales)
+    {
+        std::ostringstream os;
+        gen->write(os, n, seed);
+        auto text = std::move(os).str();
+        medians.emplace_back(n, benchInput(sel, aoc::InputView{text}, ctx, n));
+    }
 
     // NOLINTBEGIN
-    std::cout << Y << " Day " << std::setfill('0') << std::setw(2) << D
-              << " part 1: " << std::setfill(' ') << std::setw(18) << solution.part1 << "\t"
-              << " part 2: " << std::setfill(' ') << std::setw(18) << solution.part2 << "\t" << " ("
-              << duration.count() << " μs)\n";
+    std::cout << "\nscale = " << gen->description << "\n"
+              << std::setw(14) << "scale" << "  " << std::setw(13) << "median μs" << "  exponent\n";
+    for (size_t i = 0; i < medians.size(); ++i)
+    {
+        auto [n, t] = medians[i];
+        std::cout << std::setw(14) << n << "  " << std::setw(12) << std::fixed
+                  << std::setprecision(1) << t;
+        if (i > 0 && medians[i - 1].first != n && medians[i - 1].second > 0 && t > 0)
+        {
+            auto [n0, t0] = medians[i - 1];
+            std::cout << "  " << std::setprecision(2)
+                      << std::log(t / t0) /
+                             std::log(static_cast<double>(n) / static_cast<double>(n0));
+        }
+        std::cout << "\n";
+    }
     // NOLINTEND
+    return 0;
 }
 
-template <size_t Y> struct YearPrinter
+// all of `text` as a T, or nothing if it's anything else (a sign on an unsigned T, trailing junk,
+// out of range), so a bad number on the command line ends up at usage()
+template <typename T> std::optional<T> parseNumber(std::string_view text)
 {
-    template <size_t D> void printAll(bool useSample, bool includeSlow)
+    T value{};
+    auto end = std::to_address(text.end());
+    auto [last, ec] = std::from_chars(text.data(), end, value);
+    if (ec != std::errc{} || last != end)
     {
-        if constexpr (D > 0)
+        return {};
+    }
+    return value;
+}
+
+// "1e3,1e4,5e4" lists the scales; "LO:HI" steps by 10 from LO up to HI, "LO:HI:F" by F
+std::vector<size_t> parseScales(const std::string& spec)
+{
+    std::vector<size_t> scales;
+    if (auto colon = spec.find(':'); colon != std::string::npos)
+    {
+        auto rest = spec.substr(colon + 1);
+        auto second = rest.find(':');
+        auto lo = parseNumber<double>(spec.substr(0, colon));
+        auto hi = parseNumber<double>(rest.substr(0, second));
+        auto factor = second == std::string::npos ? 10.0
+                                                  : parseNumber<double>(rest.substr(second + 1));
+        if (!lo || !hi || !factor || *lo < 1 || *factor <= 1)
         {
-            printAll<D - 1>(useSample, includeSlow);
-            printSolution<Y, D>(useSample, includeSlow);
+            return {};
         }
+        for (auto n = *lo; n <= *hi * (1 + 1e-9); n *= *factor) // NOLINT(*-magic-numbers)
+        {
+            scales.push_back(static_cast<size_t>(std::llround(n)));
+        }
+        return scales;
     }
-};
+    std::istringstream is{spec};
+    for (std::string item; std::getline(is, item, ',');)
+    {
+        auto scale = parseNumber<double>(item);
+        if (!scale || *scale < 1)
+        {
+            return {};
+        }
+        scales.push_back(static_cast<size_t>(*scale));
+    }
+    return scales;
+}
+
+// Solves one day for every file in `dir`, spread over the shared pool, writing a JSONL record per
+// input to stdout as each finishes and the throughput to stderr
+int runBatch(size_t year, size_t day, const std::filesystem::path& dir)
+{
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator{dir})
+    {
+        if (entry.is_regular_file())
+        {
+            files.push_back(entry.path());
+        }
+    }
+    std::ranges::sort(files);
+
+    std::mutex outMutex;
+    size_t failures = 0;
+    auto start = std::chrono::steady_clock::now();
+    {
+        aoc::TaskGroup group;
+        for (const auto& file : files)
+        {
+            group.run(
+                [&]
+                {
+                    json line{{"input", file.filename().string()}};
+                    try
+                    {
+                        auto solveStart = std::chrono::steady_clock::now();
+                        auto [part1, part2] = aoc::runSolver(year, day, file);
+                        auto elapsed = std::chrono::duration<double, std::micro>(
+                            std::chrono::steady_clock::now() - solveStart);
+                        line["part1"] = std::move(part1);
+                        line["part2"] = std::move(part2);
+                        line["us"] = elapsed.count();
+                    }
+                    catch (const std::exception& e)
+                    {
+                        line["error"] = e.what();
+                    }
+                    auto text = line.dump();
+                    std::lock_guard lk{outMutex};
+                    failures += line.contains("error") ? 1 : 0;
+                    std::cout << text << "\n";
+                });
+        }
+        group.wait();
+    }
+    std::cout << std::flush;
+    auto seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    dayLabel(std::cerr, year, day) << ": " << files.size() << " inputs in " << std::fixed
+                                   << std::setprecision(3) << seconds << " s, "
+                                   << std::setprecision(1)
+                                   << (seconds > 0 ? static_cast<double>(files.size()) / seconds
+                                                   : 0.0)
+                                   << " inputs/s";
+    if (failures > 0)
+    {
+        std::cerr << ", " << failures << " failed";
+    }
+    std::cerr << "\n";
+    return failures > 0 ? 1 : 0;
+}
+
+int usage(const char* argv0)
+{
+    std::cerr << "usage: " << argv0
+              << " [--year Y] [--day [Y/]D] [--input PATH] [--sample] [--slow]\n"
+                 "       [--timeout SECONDS] [--no-isolate] [--no-cache]\n"
+                 "       [--bench [--part 1|2] [--warmup N] [--reps N] [--json PATH]\n"
+                 "                [--trace PATH] [--counters]]\n"
+                 "       --day Y/D --batch DIR\n"
+                 "       --day Y/D --sweep SCALES [--seed S] [bench options]\n";
+    return 2;
+}
 } // namespace
 
 int main(int argc, char* argv[])
 {
-    constexpr auto YEAR = 2018;
-    constexpr auto DAYS = 25;
+    constexpr size_t DEFAULT_YEAR = 2018;
 
-    bool includeSlow = false;
+    size_t year = DEFAULT_YEAR;
+    size_t day = 0;
+    std::filesystem::path input;
+    std::filesystem::path batchDir;
+    // generated inputs for --sweep
+    std::vector<size_t> scales;
+    uint64_t seed = 1;
+    bool useSample = false;
+    RunOptions run;
+    bool useCache = true;
+    bool bench = false;
+    BenchContext ctx;
+
+    // NOLINTBEGIN(*-pointer-arithmetic)
     for (int i = 1; i < argc; ++i)
     {
-        if (std::string(argv[i]) == // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-            "--slow")
+        std::string arg = argv[i];
+        if (arg == "--slow")
         {
-            includeSlow = true;
+            run.includeSlow = true;
+        }
+        else if (arg == "--sample")
+        {
+            useSample = true;
+        }
+        else if (arg == "--year" && i + 1 < argc)
+        {
+            auto value = parseNumber<size_t>(argv[++i]);
+            if (!value)
+            {
+                return usage(argv[0]);
+            }
+            year = *value;
+        }
+        else if (arg == "--day" && i + 1 < argc)
+        {
+            // either D, or Y/D to pick the year at the same time
+            std::string_view value = argv[++i];
+            if (auto slash = value.find('/'); slash != std::string_view::npos)
+            {
+                auto y = parseNumber<size_t>(value.substr(0, slash));
+                if (!y)
+                {
+                    return usage(argv[0]);
+                }
+                year = *y;
+                value.remove_prefix(slash + 1);
+            }
+            auto d = parseNumber<size_t>(value);
+            if (!d)
+            {
+                return usage(argv[0]);
+            }
+            day = *d;
+        }
+        else if (arg == "--sweep" && i + 1 < argc)
+        {
+            scales = parseScales(argv[++i]);
+            if (scales.empty())
+            {
+                return usage(argv[0]);
+            }
+        }
+        else if (arg == "--seed" && i + 1 < argc)
+        {
+            auto value = parseNumber<uint64_t>(argv[++i]);
+            if (!value)
+            {
+                return usage(argv[0]);
+            }
+            seed = *value;
+        }
+        else if (arg == "--batch" && i + 1 < argc)
+        {
+            batchDir = argv[++i];
+        }
+        else if (arg == "--input" && i + 1 < argc)
+        {
+            input = argv[++i];
+        }
+        else if (arg == "--timeout" && i + 1 < argc)
+        {
+            // seconds, 0 for no limit
+            auto secs = parseNumber<uint32_t>(argv[++i]);
+            if (!secs)
+            {
+                return usage(argv[0]);
+            }
+            run.timeout.reset();
+            if (*secs > 0)
+            {
+                run.timeout = std::chrono::seconds{*secs};
+            }
+        }
+        else if (arg == "--no-cache")
+        {
+            useCache = false;
+        }
+        else if (arg == "--no-isolate")
+        {
+            run.isolate = false;
+        }
+        else if (arg == "--bench")
+        {
+            bench = true;
+        }
+        else if (arg == "--part" && i + 1 < argc)
+        {
+            auto part = parseNumber<int>(argv[++i]);
+            if (!part)
+            {
+                return usage(argv[0]);
+            }
+            ctx.part = *part;
+        }
+        else if ((arg == "--warmup" || arg == "--reps") && i + 1 < argc)
+        {
+            auto count = parseNumber<size_t>(argv[++i]);
+            if (!count)
+            {
+                return usage(argv[0]);
+            }
+            (arg == "--warmup" ? ctx.opts.warmup : ctx.opts.reps) = *count;
+        }
+        else if (arg == "--json" && i + 1 < argc)
+        {
+            ctx.reportPath = argv[++i];
+        }
+        else if (arg == "--trace" && i + 1 < argc)
+        {
+            ctx.tracePath = argv[++i];
+        }
+        else if (arg == "--counters")
+        {
+            ctx.counters.emplace();
+        }
+        else
+        {
+            return usage(argv[0]);
         }
     }
+    // NOLINTEND(*-pointer-arithmetic)
 
-    YearPrinter<YEAR>{}.printAll<DAYS>(false, includeSlow);
+    if (std::ranges::find(aoc::YEARS, year) == aoc::YEARS.end() || day > aoc::NUM_DAYS ||
+        (!input.empty() && day == 0) || ctx.part < 0 || ctx.part > 2 ||
+        (!batchDir.empty() && (day == 0 || !std::filesystem::is_directory(batchDir))) ||
+        (!scales.empty() && day == 0))
+    {
+        return usage(argv[0]);
+    }
+
+    if (!batchDir.empty())
+    {
+        return runBatch(year, day, batchDir);
+    }
+    // a sweep is a benchmark
+    bench = bench || !scales.empty();
+
+    if (ctx.counters && !ctx.counters->available())
+    {
+        std::cerr << "hardware counters unavailable (" << ctx.counters->unavailableReason()
+                  << "), reporting wall time only\n";
+        ctx.counters.reset();
+    }
+
+    // the benchmark always solves for real
+    if (useCache && !bench)
+    {
+        run.cache.emplace("cache.json");
+    }
+
+    int status = 0;
+    std::vector<Selection> selected;
+    if (!scales.empty())
+    {
+        status = benchSweep({year, day, {}}, scales, seed, ctx);
+    }
+    for (size_t d = 1; d <= aoc::NUM_DAYS && scales.empty(); ++d)
+    {
+        if (day == 0 || day == d)
+        {
+            selected.push_back({year, d, input.empty() ? inputPath(year, d, useSample) : input});
+        }
+    }
+
+    for (const auto& sel : selected)
+    {
+        if (bench)
+        {
+            benchSolution(sel, run.includeSlow, ctx);
+        }
+        else
+        {
+            printSolution(sel, run);
+        }
+    }
+
+    if (run.cache)
+    {
+        run.cache->save();
+    }
+
+    if (bench)
+    {
+        std::ofstream ofs{ctx.reportPath};
+        ofs << ctx.report.dump(2) << "\n";
+        if (!ctx.tracePath.empty())
+        {
+            std::ofstream trace{ctx.tracePath};
+            trace << json{{"traceEvents", ctx.traceEvents}, {"displayTimeUnit", "ms"}}.dump()
+                  << "\n";
+        }
+    }
+    return status;
 }
@@ -1,12 +1,27 @@
+#include "allocprof.hh"
+#include "bench.hh"
 #include "dispatch.hh"
+#include "isolate.hh"
+#include "resultcache.hh"
+#include "threadpool.hh"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <mutex>
 #include <nlohmann/json.hpp>
+#include <numeric>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace
 {
@@ -64,84 +79,506 @@ struct Stats
     int passed = 0;
     int failed = 0;
     int skipped = 0;
+    int timedOut = 0;
 };
 
-void processDay(bool record, size_t year, size_t day, const std::filesystem::path& root,
-                json& answers, Stats& stats)
+enum class Outcome
+{
+    PASS,
+    FAIL,
+    SKIP,
+    RECORD,
+    TIMEOUT,
+};
+
+struct RunOptions
+{
+    bool record = false;
+    // fork a child per day; without it a hung solver hangs verify
+    bool isolate = true;
+    // per-day wall-clock budget when isolated, none if empty
+    std::optional<std::chrono::milliseconds> timeout = std::chrono::seconds{120}; // NOLINT
+    // shared pool size inside an isolated child, so concurrent days split the cores between them
+    size_t childThreads = std::thread::hardware_concurrency();
+};
+
+// Everything a worker learns about one day; the main thread turns these into output and Stats so
+// that the report reads the same regardless of which order the pool finished in
+struct DayResult
+{
+    Outcome outcome = Outcome::SKIP;
+    std::string report;
+    std::string p1;
+    std::string p2;
+    std::optional<std::chrono::microseconds> duration;
+    // only known for isolated runs
+    std::optional<long> peakRssKb;
+    bool cached = false;
+};
+
+std::ostream& dayLabel(std::ostream& os, size_t year, size_t day)
+{
+    return os << year << " Day " << std::setfill('0') << std::setw(2) << day;
+}
+
+bool wanted(const RunOptions& opts, const json& answers, size_t year, size_t day)
+{
+    auto yearKey = std::to_string(year);
+    return opts.record ||
+           (answers.contains(yearKey) && answers.at(yearKey).contains(std::to_string(day)));
+}
+
+// `cache` is null when caching is off, and `cacheKey` is computed up front (see main)
+DayResult processDay(const RunOptions& opts, size_t year, size_t day,
+                     const std::filesystem::path& root, const json& answers,
+                     aoc::cache::ResultCache* cache, const std::string& cacheKey)
 {
     auto yearKey = std::to_string(year);
     auto dayKey = std::to_string(day);
+    DayResult result;
+    std::ostringstream out;
 
-    if (!record && (!answers.contains(yearKey) || !answers[yearKey].contains(dayKey)))
+    if (!wanted(opts, answers, year, day))
     {
-        ++stats.skipped;
-        return;
+        return result;
     }
 
-    std::ifstream ifs{inputPath(root, year, day)};
-    if (!ifs)
+    auto path = inputPath(root, year, day);
+    if (!std::filesystem::is_regular_file(path))
     {
-        if (!record)
+        if (!opts.record)
         {
-            std::cout << YELLOW << "SKIP" << RESET << "  " << year << " Day " << std::setfill('0')
-                      << std::setw(2) << day << "  (no input file)\n";
+            out << YELLOW << "SKIP" << RESET << "  ";
+            dayLabel(out, year, day) << "  (no input file)\n";
         }
-        ++stats.skipped;
-        return;
+        result.report = out.str();
+        return result;
+    }
+
+    auto input = aoc::InputView::open(path);
+    std::optional<aoc::cache::Entry> hit;
+    if (cache)
+    {
+        hit = cache->find(year, day, cacheKey);
     }
 
-    auto [p1, p2] = aoc::runSolver(year, day, ifs);
+    auto solve = [&]
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto solution = aoc::runSolver(year, day, input);
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+        return std::pair{solution, elapsed};
+    };
+
+    std::string p1;
+    std::string p2;
+    if (hit)
+    {
+        p1 = std::move(hit->part1);
+        p2 = std::move(hit->part2);
+        result.duration = hit->duration;
+        result.cached = true;
+    }
+    else if (!opts.isolate)
+    {
+        auto [solution, elapsed] = solve();
+        std::tie(p1, p2) = std::move(solution);
+        result.duration = elapsed;
+    }
+    else
+    {
+        auto run = aoc::isolate::run(
+            [&]
+            {
+                aoc::ThreadPool::setSharedSize(opts.childThreads);
+                auto [solution, elapsed] = solve();
+                return aoc::isolate::pack(
+                    {solution.first, solution.second, std::to_string(elapsed.count())});
+            },
+            opts.timeout);
+        result.peakRssKb = run.peakRssKb;
+        auto fields = aoc::isolate::unpack(run.output);
+        if (run.status == aoc::isolate::Status::TIMEOUT)
+        {
+            out << RED << "TIME" << RESET << "  ";
+            dayLabel(out, year, day)
+                << "  (killed after "
+                << std::chrono::duration_cast<std::chrono::seconds>(run.wall).count() << " s)\n";
+            result.outcome = Outcome::TIMEOUT;
+            // so the scheduler starts it first next time
+            result.duration = run.wall;
+            result.report = out.str();
+            return result;
+        }
+        if (run.status != aoc::isolate::Status::OK || fields.size() != 3)
+        {
+            out << RED << "FAIL" << RESET << "  ";
+            dayLabel(out, year, day) << "  " << aoc::isolate::describe(run) << "\n";
+            result.outcome = Outcome::FAIL;
+            result.report = out.str();
+            return result;
+        }
+        p1 = std::move(fields[0]);
+        p2 = std::move(fields[1]);
+        result.duration = std::chrono::microseconds{std::stoll(fields[2])};
+    }
+    if (cache && !hit)
+    {
+        cache->store(year, day, cacheKey, {p1, p2, *result.duration});
+    }
 
-    if (record)
+    if (opts.record)
     {
         // Skip unimplemented stubs (both parts are default values)
         if ((p1 == "0" || p1.empty()) && (p2 == "0" || p2.empty()))
         {
-            std::cout << YELLOW << "SKIP" << RESET << "  " << year << " Day " << std::setfill('0')
-                      << std::setw(2) << day << "  (default values)\n";
-            ++stats.skipped;
-            return;
+            out << YELLOW << "SKIP" << RESET << "  ";
+            dayLabel(out, year, day) << "  (default values)\n";
+        }
+        else
+        {
+            out << GREEN << "REC " << RESET << "  ";
+            dayLabel(out, year, day) << "  [" << p1 << ", " << p2 << "]\n";
+            result.outcome = Outcome::RECORD;
         }
-        answers[yearKey][dayKey] = {p1, p2};
-        std::cout << GREEN << "REC " << RESET << "  " << year << " Day " << std::setfill('0')
-                  << std::setw(2) << day << "  [" << p1 << ", " << p2 << "]\n";
-        ++stats.passed;
     }
     else
     {
-        const auto& expected = answers[yearKey][dayKey];
+        const auto& expected = answers.at(yearKey).at(dayKey);
         auto exp1 = expected[0].get<std::string>();
         auto exp2 = expected[1].get<std::string>();
         bool ok = (p1 == exp1 && p2 == exp2);
         if (ok)
         {
-            std::cout << GREEN << "PASS" << RESET << "  " << year << " Day " << std::setfill('0')
-                      << std::setw(2) << day << "\n";
-            ++stats.passed;
+            out << GREEN << "PASS" << RESET << "  ";
+            dayLabel(out, year, day);
+            if (result.cached)
+            {
+                out << "  (cached)";
+            }
+            else if (result.peakRssKb)
+            {
+                out << "  (" << *result.peakRssKb / 1024 << " MiB peak)"; // NOLINT
+            }
+            out << "\n";
+            result.outcome = Outcome::PASS;
         }
         else
         {
-            std::cout << RED << "FAIL" << RESET << "  " << year << " Day " << std::setfill('0')
-                      << std::setw(2) << day;
+            out << RED << "FAIL" << RESET << "  ";
+            dayLabel(out, year, day);
             if (p1 != exp1)
             {
-                std::cout << "  part1: got " << p1 << " expected " << exp1;
+                out << "  part1: got " << p1 << " expected " << exp1;
             }
             if (p2 != exp2)
             {
-                std::cout << "  part2: got " << p2 << " expected " << exp2;
+                out << "  part2: got " << p2 << " expected " << exp2;
             }
-            std::cout << "\n";
-            ++stats.failed;
+            out << "\n";
+            result.outcome = Outcome::FAIL;
         }
     }
+    result.report = out.str();
+    result.p1 = std::move(p1);
+    result.p2 = std::move(p2);
+    return result;
+}
+
+// Wall-clock durations from previous runs, used to start the longest days first
+json loadTimings(const std::filesystem::path& root)
+{
+    auto path = root / "timings.json";
+    if (!std::filesystem::exists(path))
+    {
+        return json::object();
+    }
+    std::ifstream ifs{path};
+    // a stale or truncated timings file only costs scheduling quality, so don't fail on it
+    auto timings = json::parse(ifs, nullptr, false);
+    return timings.is_object() ? timings : json::object();
+}
+
+void saveTimings(const std::filesystem::path& root, const json& timings)
+{
+    std::ofstream ofs{root / "timings.json"};
+    ofs << timings.dump(2) << "\n";
+}
+
+int64_t expectedMicros(const json& timings, size_t year, size_t day)
+{
+    auto yearKey = std::to_string(year);
+    auto dayKey = std::to_string(day);
+    if (!timings.contains(yearKey) || !timings.at(yearKey).contains(dayKey))
+    {
+        // unknown days go first: they might be the slow ones
+        return std::numeric_limits<int64_t>::max();
+    }
+    return timings.at(yearKey).at(dayKey).get<int64_t>();
+}
+
+struct PerfOptions
+{
+    // write perf_baseline.json from this run
+    bool record = false;
+    bool enabled = true;
+    // a day fails once its timings are significantly above baseline * (1 + threshold)
+    double threshold = 0.10;
+    double alpha = 0.01;
+    aoc::bench::Options bench{.warmup = 1, .reps = 10};
+};
+
+// null without a usable baseline.  A damaged file is only a warning: it mustn't cost the rest of
+// the run's results, and --record-perf has to be able to replace it
+json loadPerfBaseline(const std::filesystem::path& root)
+{
+    auto path = root / "perf_baseline.json";
+    if (!std::filesystem::exists(path))
+    {
+        return nullptr;
+    }
+    std::ifstream ifs{path};
+    auto baseline = json::parse(ifs, nullptr, false);
+    if (!baseline.is_object())
+    {
+        std::cerr << "ignoring unreadable " << path.string() << "\n";
+        return nullptr;
+    }
+    return baseline;
+}
+
+void savePerfBaseline(const std::filesystem::path& root, const json& baseline)
+{
+    std::ofstream ofs{root / "perf_baseline.json"};
+    ofs << baseline.dump(2) << "\n";
+}
+
+struct PerfRun
+{
+    std::vector<double> samples;
+    // median per solve, only with the allocation profiler linked in
+    std::optional<uint64_t> allocations;
+};
+
+// Repeated in-process solves of one day against a single mapping of its input
+PerfRun measureDay(size_t year, size_t day, const std::filesystem::path& root,
+                   const aoc::bench::Options& opts)
+{
+    auto file = aoc::InputView::open(inputPath(root, year, day));
+    std::optional<aoc::InputView> input;
+    std::vector<uint64_t> allocs;
+    PerfRun run;
+    run.samples = aoc::bench::measure(
+        opts, [&] { input.emplace(file.text()); },
+        [&]
+        {
+            aoc::alloc::Scope scope;
+            aoc::runSolver(year, day, *input);
+            allocs.push_back(scope.stop().allocations);
+        });
+    if (aoc::alloc::enabled() && !allocs.empty())
+    {
+        std::ranges::nth_element(allocs, std::next(allocs.begin(),
+                                                   static_cast<std::ptrdiff_t>(allocs.size() / 2)));
+        run.allocations = allocs[allocs.size() / 2];
+    }
+    return run;
+}
+
+// entry[key] as numbers, if it's an array of nothing else
+std::optional<std::vector<double>> numbers(const json& entry, const char* key)
+{
+    if (!entry.is_object() || !entry.contains(key) || !entry.at(key).is_array() ||
+        !std::ranges::all_of(entry.at(key), [](const json& x) { return x.is_number(); }))
+    {
+        return {};
+    }
+    return entry.at(key).get<std::vector<double>>();
+}
+
+// measureDay in a child under the same budget as the correctness pass, unless isolation is off.
+// Nothing if the reruns didn't finish, after reporting why.
+std::optional<PerfRun> timeDay(const RunOptions& runOpts, size_t year, size_t day,
+                               const std::filesystem::path& root, const aoc::bench::Options& opts)
+{
+    if (!runOpts.isolate)
+    {
+        return measureDay(year, day, root, opts);
+    }
+    auto result = aoc::isolate::run(
+        [&]
+        {
+            auto run = measureDay(year, day, root, opts);
+            return json{{"samples_us", run.samples},
+                        {"allocations", run.allocations ? json(*run.allocations) : json(nullptr)}}
+                .dump();
+        },
+        runOpts.timeout);
+    auto parsed = json::parse(result.output, nullptr, false);
+    auto samples = numbers(parsed, "samples_us");
+    if (result.status == aoc::isolate::Status::OK && samples)
+    {
+        PerfRun run{std::move(*samples), {}};
+        if (parsed.contains("allocations") && parsed.at("allocations").is_number_unsigned())
+        {
+            run.allocations = parsed.at("allocations").get<uint64_t>();
+        }
+        return run;
+    }
+    std::ostringstream out;
+    if (result.status == aoc::isolate::Status::TIMEOUT)
+    {
+        out << RED << "TIME" << RESET << "  ";
+        dayLabel(out, year, day)
+            << "  (perf reruns killed after "
+            << std::chrono::duration_cast<std::chrono::seconds>(result.wall).count() << " s)\n";
+    }
+    else
+    {
+        out << RED << "FAIL" << RESET << "  ";
+        dayLabel(out, year, day) << "  perf reruns " << aoc::isolate::describe(result) << "\n";
+    }
+    std::cout << out.str();
+    return {};
+}
+
+struct PerfDay
+{
+    size_t year;
+    size_t day;
+    // the day's result cache key, empty with caching off
+    std::string cacheKey;
+};
+
+// Times every day in `days` one at a time, so they don't compete for cores, and either records them
+// into `baseline` or compares against it.  A day whose solver object and input are byte for byte
+// what its baseline measured can't have regressed, so it isn't rerun.  Returns the number of days
+// that regressed or whose reruns didn't finish.
+int checkPerf(const PerfOptions& opts, const RunOptions& runOpts, const std::vector<PerfDay>& days,
+              const std::filesystem::path& root, json& baseline)
+{
+    int regressions = 0;
+    int failures = 0;
+    int compared = 0;
+    int unchanged = 0;
+    for (const auto& [year, day, cacheKey] : days)
+    {
+        auto yearKey = std::to_string(year);
+        auto dayKey = std::to_string(day);
+        const json* base = nullptr;
+        std::optional<std::vector<double>> baseSamples;
+        if (!opts.record)
+        {
+            if (!baseline.contains(yearKey) || !baseline.at(yearKey).contains(dayKey))
+            {
+                continue;
+            }
+            base = &baseline.at(yearKey).at(dayKey);
+            baseSamples = numbers(*base, "samples_us");
+            if (!baseSamples || baseSamples->empty() || !base->contains("median_us") ||
+                !base->at("median_us").is_number())
+            {
+                std::ostringstream out;
+                out << YELLOW << "SKIP" << RESET << "  ";
+                dayLabel(out, year, day) << "  (incomplete perf baseline entry)\n";
+                std::cout << out.str();
+                continue;
+            }
+            if (!cacheKey.empty() && base->contains("cache_key") &&
+                base->at("cache_key") == cacheKey)
+            {
+                ++unchanged;
+                continue;
+            }
+        }
+
+        auto timed = timeDay(runOpts, year, day, root, opts.bench);
+        if (!timed)
+        {
+            ++failures;
+            continue;
+        }
+        auto& run = *timed;
+        auto median = aoc::bench::summarize(run.samples).median;
+        if (opts.record)
+        {
+            baseline[yearKey][dayKey] = {
+                {"median_us", median},
+                {"samples_us", run.samples},
+                {"allocations", run.allocations ? json(*run.allocations) : json(nullptr)}};
+            if (!cacheKey.empty())
+            {
+                baseline[yearKey][dayKey]["cache_key"] = cacheKey;
+            }
+            std::ostringstream out;
+            out << GREEN << "PERF" << RESET << "  ";
+            dayLabel(out, year, day)
+                << "  " << std::fixed << std::setprecision(1) << median << " μs\n";
+            std::cout << out.str();
+            continue;
+        }
+
+        ++compared;
+        auto baseMedian = base->at("median_us").get<double>();
+        // test against the baseline as stretched by the allowance, so a significant result means
+        // slower by more than the threshold rather than merely slower
+        for (auto& x : *baseSamples)
+        {
+            x *= 1 + opts.threshold;
+        }
+        auto p = aoc::bench::mannWhitneyGreater(*baseSamples, run.samples);
+        bool slower = p < opts.alpha;
+
+        std::optional<uint64_t> baseAllocs;
+        if (base->contains("allocations") && base->at("allocations").is_number_unsigned())
+        {
+            baseAllocs = base->at("allocations").get<uint64_t>();
+        }
+        bool moreAllocs = run.allocations && baseAllocs &&
+                          static_cast<double>(*run.allocations) >
+                              static_cast<double>(*baseAllocs) * (1 + opts.threshold);
+        if (!slower && !moreAllocs)
+        {
+            continue;
+        }
+        ++regressions;
+        auto percent = (median / baseMedian - 1) * 100; // NOLINT(*-magic-numbers)
+        std::ostringstream out;
+        out << RED << "SLOW" << RESET << "  ";
+        dayLabel(out, year, day)
+            << std::fixed << std::setprecision(1) << "  median " << median << " μs vs "
+            << baseMedian << " μs (" << std::showpos << percent << std::noshowpos
+            << "%, p=" << std::setprecision(4) << p << ")";
+        if (moreAllocs)
+        {
+            out << "  allocations " << *run.allocations << " vs " << *baseAllocs;
+        }
+        std::cout << out.str() << "\n";
+    }
+    if (!opts.record)
+    {
+        std::cout << "\nperf: " << compared << " days compared, " << unchanged
+                  << " unchanged since the baseline, " << regressions
+                  << " slower than baseline +" << opts.threshold * 100 // NOLINT
+                  << "%";
+        if (failures > 0)
+        {
+            std::cout << ", " << failures << " didn't finish";
+        }
+        std::cout << "\n";
+    }
+    return regressions + failures;
 }
 } // namespace
 
 int main(int argc, char* argv[])
 {
-    bool record = false;
+    RunOptions opts;
+    PerfOptions perf;
+    bool useCache = true;
     size_t yearFilter = 0;
+    size_t jobs = std::thread::hardware_concurrency();
 
     // NOLINTBEGIN(*-pointer-arithmetic)
     for (int i = 1; i < argc; ++i)
@@ -149,41 +586,194 @@ int main(int argc, char* argv[])
         std::string arg = argv[i];
         if (arg == "--record")
         {
-            record = true;
+            opts.record = true;
+        }
+        else if (arg == "--record-perf")
+        {
+            perf.record = true;
+        }
+        else if (arg == "--no-perf")
+        {
+            perf.enabled = false;
+        }
+        else if (arg == "--threshold" && i + 1 < argc)
+        {
+            // percent
+            perf.threshold = std::atof(argv[++i]) / 100; // NOLINT(*-magic-numbers)
+        }
+        else if (arg == "--reps" && i + 1 < argc)
+        {
+            perf.bench.reps = static_cast<size_t>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--no-cache")
+        {
+            useCache = false;
+        }
+        else if (arg == "--no-isolate")
+        {
+            opts.isolate = false;
+        }
+        else if (arg == "--timeout" && i + 1 < argc)
+        {
+            // seconds, 0 for no limit
+            auto secs = std::atoi(argv[++i]);
+            opts.timeout.reset();
+            if (secs > 0)
+            {
+                opts.timeout = std::chrono::seconds{secs};
+            }
         }
         else if (arg == "--year" && i + 1 < argc)
         {
             yearFilter = static_cast<size_t>(std::atoi(argv[++i]));
         }
+        else if ((arg == "--jobs" || arg == "-j") && i + 1 < argc)
+        {
+            jobs = static_cast<size_t>(std::atoi(argv[++i]));
+        }
     }
     // NOLINTEND(*-pointer-arithmetic)
+    jobs = std::max<size_t>(jobs, 1);
+    opts.childThreads = std::max<size_t>(std::thread::hardware_concurrency() / jobs, 1);
 
     auto root = findProjectRoot();
     auto answers = loadAnswers(root);
+    auto timings = loadTimings(root);
+    auto baseline = loadPerfBaseline(root);
+    std::optional<aoc::cache::ResultCache> cache;
+    if (useCache)
+    {
+        cache.emplace(root / "cache.json");
+    }
     Stats stats;
 
-    constexpr size_t DAYS = 25;
-
-    auto runYear = [&](size_t year, auto fn)
+    std::vector<std::pair<size_t, size_t>> days;
+    for (size_t year : aoc::YEARS)
     {
         if (yearFilter != 0 && yearFilter != year)
         {
-            return;
+            continue;
         }
-        for (size_t day = 1; day <= DAYS; ++day)
+        for (size_t day = 1; day <= aoc::NUM_DAYS; ++day)
         {
-            fn(year, day);
+            days.emplace_back(year, day);
         }
-    };
+    }
+
+    // Longest-processing-time-first: with the slow days started immediately, the run finishes
+    // close to the duration of the slowest single day
+    std::vector<size_t> schedule(days.size());
+    std::iota(schedule.begin(), schedule.end(), 0UZ);
+    std::ranges::stable_sort(schedule, std::greater{},
+                             [&](size_t i)
+                             { return expectedMicros(timings, days[i].first, days[i].second); });
 
-    // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
-    for (size_t year : {2015UL, 2016UL, 2017UL, 2018UL, 2024UL, 2025UL})
+    // Hashed before any worker starts: a day forked while a sibling was inside OpenSSL could
+    // inherit one of its locks held and hang until the timeout
+    std::vector<std::string> cacheKeys(days.size());
+    for (size_t i = 0; i < days.size() && cache; ++i)
     {
-        runYear(year, [&](size_t y, size_t d) { processDay(record, y, d, root, answers, stats); });
+        auto [year, day] = days[i];
+        auto path = inputPath(root, year, day);
+        if (wanted(opts, answers, year, day) && std::filesystem::is_regular_file(path))
+        {
+            cacheKeys[i] = aoc::cache::key(year, day, aoc::InputView::open(path).text());
+        }
     }
-    // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
 
-    if (record)
+    std::vector<std::optional<DayResult>> results(days.size());
+    std::mutex resultsMutex;
+    std::condition_variable resultReady;
+    {
+        aoc::ThreadPool pool{jobs};
+        for (auto i : schedule)
+        {
+            pool.submit(
+                [&, i]
+                {
+                    auto [year, day] = days[i];
+                    DayResult res;
+                    try
+                    {
+                        res = processDay(opts, year, day, root, answers,
+                                         cache ? &*cache : nullptr, cacheKeys[i]);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        std::ostringstream out;
+                        out << RED << "FAIL" << RESET << "  ";
+                        dayLabel(out, year, day) << "  threw: " << e.what() << "\n";
+                        res.outcome = Outcome::FAIL;
+                        res.report = out.str();
+                    }
+                    std::lock_guard lk{resultsMutex};
+                    results[i] = std::move(res);
+                    resultReady.notify_one();
+                });
+        }
+
+        // Report in (year, day) order as soon as each prefix of the results is complete
+        for (size_t i = 0; i < days.size(); ++i)
+        {
+            std::unique_lock lk{resultsMutex};
+            resultReady.wait(lk, [&] { return results[i].has_value(); });
+            auto& res = *results[i];
+            lk.unlock();
+
+            auto [year, day] = days[i];
+            std::cout << res.report << std::flush;
+            switch (res.outcome)
+            {
+            case Outcome::PASS: ++stats.passed; break;
+            case Outcome::FAIL: ++stats.failed; break;
+            case Outcome::SKIP: ++stats.skipped; break;
+            case Outcome::TIMEOUT: ++stats.timedOut; break;
+            case Outcome::RECORD:
+                answers[std::to_string(year)][std::to_string(day)] = {res.p1, res.p2};
+                ++stats.passed;
+                break;
+            }
+            if (res.duration)
+            {
+                timings[std::to_string(year)][std::to_string(day)] = res.duration->count();
+            }
+        }
+        pool.wait();
+    }
+
+    // Only days that came out right are worth timing; slow days would take minutes per rep
+    int regressions = 0;
+    if (perf.enabled && (perf.record || !baseline.is_null()))
+    {
+        std::vector<PerfDay> timed;
+        for (size_t i = 0; i < days.size(); ++i)
+        {
+            auto outcome = results[i]->outcome;
+            auto [year, day] = days[i];
+            if ((outcome == Outcome::PASS || outcome == Outcome::RECORD) &&
+                !aoc::isSlow(year, day))
+            {
+                timed.push_back({year, day, cacheKeys[i]});
+            }
+        }
+        std::cout << "\n";
+        if (perf.record && !baseline.is_object())
+        {
+            baseline = json::object();
+        }
+        regressions = checkPerf(perf, opts, timed, root, baseline);
+        if (perf.record)
+        {
+            savePerfBaseline(root, baseline);
+        }
+    }
+
+    saveTimings(root, timings);
+    if (cache)
+    {
+        cache->save();
+    }
+    if (opts.record)
     {
         saveAnswers(root, answers);
         std::cout << "\nRecorded " << stats.passed << " solutions to answers.json\n";
@@ -191,9 +781,9 @@ int main(int argc, char* argv[])
     else
     {
         std::cout << "\n"
-                  << stats.passed << " passed, " << stats.failed << " failed, " << stats.skipped
-                  << " skipped\n";
+                  << stats.passed << " passed, " << stats.failed << " failed, " << stats.timedOut
+                  << " timed out, " << stats.skipped << " skipped\n";
     }
 
-    return stats.failed > 0 ? 1 : 0;
+    return stats.failed > 0 || stats.timedOut > 0 || regressions > 0 ? 1 : 0;
 }
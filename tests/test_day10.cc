@@ -1,20 +1,80 @@
 #include <catch2/catch_test_macros.hpp>
+#include <numeric>
+#include <random>
 //NOLINTBEGIN
 #include "../src/2025/day10.cc"
 
-TEST_CASE("Reduce Helper", "[linalg]") {
-    std::vector<std::vector<float>> cols;
-    std::vector<float> coeffs {1.0f};
-    std::vector<float> orig {2.f, 3.f, 4.f };
-    cols.push_back({4.f, 3.f, 2.f});
-    aoc::reduceHelper(cols, coeffs, orig);
-    REQUIRE( orig == std::vector{-2.f, 0.f, 2.f});
+namespace {
+// a machine whose joltages come from pressing random buttons a random number of times each, and
+// the total number of presses that were drawn
+std::pair<aoc::ilp::Problem, int64_t> plantedMachine(std::mt19937& rng, size_t counters,
+                                                     size_t buttons, int64_t presses) {
+    aoc::ilp::Problem p;
+    p.equalities.assign(counters, std::vector<int64_t>(buttons));
+    p.rhs.assign(counters, 0);
+    p.upper.assign(buttons, std::numeric_limits<int64_t>::max());
+    p.cost.assign(buttons, 1);
+    std::uniform_int_distribution<int64_t> times{0, presses};
+    int64_t planted{};
+    for (size_t c = 0; c < buttons; c++) {
+        auto n = times(rng);
+        planted += n;
+        for (size_t r = 0; r < counters; r++) {
+            if (rng() % 2 || r == c % counters) {
+                p.equalities[r][c] = 1;
+                p.rhs[r] += n;
+            }
+        }
+    }
+    for (size_t c = 0; c < buttons; c++) {
+        for (size_t r = 0; r < counters; r++) {
+            if (p.equalities[r][c]) {
+                p.upper[c] = std::min(p.upper[c], p.rhs[r]);
+            }
+        }
+    }
+    return {p, planted};
+}
+
+// cheapest solution by trying every count of every variable, for non-negative coefficients
+std::optional<int64_t> exhaustive(const aoc::ilp::Problem& p, size_t c,
+                                  std::vector<int64_t>& left) {
+    if (c == p.cost.size()) {
+        return std::ranges::all_of(left, [](auto v) { return v == 0; }) ? std::optional<int64_t>{0}
+                                                                         : std::nullopt;
+    }
+    std::optional<int64_t> best;
+    int64_t k = 0;
+    for (bool fits = true; fits; k++) {
+        if (auto rest = exhaustive(p, c + 1, left)) {
+            auto v = k * p.cost[c] + *rest;
+            best = best ? std::min(*best, v) : v;
+        }
+        for (size_t r = 0; r < left.size(); r++) {
+            left[r] -= p.equalities[r][c];
+            fits = fits && left[r] >= 0;
+        }
+        fits = fits && k < p.upper[c];
+    }
+    for (size_t r = 0; r < left.size(); r++) {
+        left[r] += k * p.equalities[r][c];
+    }
+    return best;
+}
 
-    cols.push_back({7.f, 1.f, 4.f});
-    coeffs.push_back(-1.f);
-    aoc::reduceHelper(cols, coeffs, orig);
-    REQUIRE( orig == std::vector{1.f,-2.f, 4.f });
+void requireSolves(const aoc::ilp::Problem& p, const aoc::ilp::Solution& s) {
+    REQUIRE(std::inner_product(s.x.begin(), s.x.end(), p.cost.begin(), int64_t{}) == s.value);
+    for (size_t r = 0; r < p.rhs.size(); r++) {
+        int64_t sum{};
+        for (size_t c = 0; c < s.x.size(); c++) {
+            REQUIRE(s.x[c] >= 0);
+            REQUIRE(s.x[c] <= p.upper[c]);
+            sum += p.equalities[r][c] * s.x[c];
+        }
+        REQUIRE(sum == p.rhs[r]);
+    }
 }
+} // namespace
 
 TEST_CASE("Matrix", "[linalg]") {
     Matrix<float> m1{ {1,2,3}, {4,5,6}};
@@ -31,4 +91,101 @@ TEST_CASE("Matrix", "[linalg]") {
     REQUIRE(m1 == Matrix<float>{{1,0,-1}, {0,1, 2}});
 }
 
+TEST_CASE("Bareiss", "[linalg]") {
+    Matrix<long> m{ {1,2,3}, {4,5,6}};
+    REQUIRE(m.bareissReduce() == -3);
+    REQUIRE(m == Matrix<long>{{-3,0,3}, {0,-3,-6}});
+
+    REQUIRE(Matrix<long>{{2,1,1}, {1,3,2}, {1,0,0}}.determinant() == -1);
+    REQUIRE(Matrix<long>{{0,1}, {1,0}}.determinant() == -1);
+    REQUIRE(Matrix<long>{{1,2}, {2,4}}.determinant() == 0);
+}
+
+TEST_CASE("ILP agrees with exhaustive search", "[ilp]") {
+    std::mt19937 rng{2025};
+    for (int i = 0; i < 60; i++) {
+        auto [p, planted] = plantedMachine(rng, 3 + i % 3, 3 + i % 5, 6);
+        auto left = p.rhs;
+        auto expected = exhaustive(p, 0, left);
+        auto s = aoc::ilp::minimize(p);
+        REQUIRE(expected);
+        REQUIRE(*expected <= planted);
+        REQUIRE(s);
+        REQUIRE(s->value == *expected);
+        requireSolves(p, *s);
+    }
+}
+
+TEST_CASE("ILP with weighted costs", "[ilp]") {
+    // phase 1 left an artificial basic in a bound row, which phase 2 then moved off zero
+    aoc::ilp::Problem p{
+        {{2, 0, 1, 0, 0}, {0, 0, 0, 1, 0}}, {8, 4}, {3, 3, 3, 4, 2}, {2, 1, 3, 2, 3}};
+    auto s = aoc::ilp::minimize(p);
+    REQUIRE(s);
+    REQUIRE(s->value == 20);
+    requireSolves(p, *s);
+
+    std::mt19937 rng{7};
+    for (int i = 0; i < 2000; i++) {
+        size_t n = 2 + rng() % 5;
+        aoc::ilp::Problem q{std::vector<std::vector<int64_t>>(1 + rng() % 3), {}, {}, {}};
+        std::vector<int64_t> x;
+        for (size_t c = 0; c < n; c++) {
+            q.upper.push_back(rng() % 5);
+            q.cost.push_back(rng() % 4);
+            x.push_back(rng() % (q.upper.back() + 1));
+        }
+        for (auto& row : q.equalities) {
+            int64_t b{};
+            for (size_t c = 0; c < n; c++) {
+                b += row.emplace_back(rng() % 3) * x[c];
+            }
+            q.rhs.push_back(b);
+        }
+        auto left = q.rhs;
+        auto expected = exhaustive(q, 0, left);
+        auto got = aoc::ilp::minimize(q);
+        REQUIRE(expected);
+        REQUIRE(got);
+        REQUIRE(got->value == *expected);
+        requireSolves(q, *got);
+    }
+}
+
+TEST_CASE("ILP without integer solutions", "[ilp]") {
+    // every button lights two of three counters, so the presses would have to total 3/2
+    aoc::ilp::Problem p{{{1, 0, 1}, {1, 1, 0}, {0, 1, 1}}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}};
+    REQUIRE_FALSE(aoc::ilp::minimize(p));
+    p.rhs = {2, 2, 2};
+    REQUIRE(aoc::ilp::minimize(p)->value == 3);
+    // x + y = 3 but x <= 1 and y <= 1
+    REQUIRE_FALSE(aoc::ilp::minimize({{{1, 1}}, {3}, {1, 1}, {1, 1}}));
+}
+
+TEST_CASE("ILP overflow", "[ilp]") {
+    // the tableau outgrows int64, which has to throw rather than wrap in every build
+    constexpr int64_t BIG = int64_t{1} << 40;
+    aoc::ilp::Problem p{{{BIG, 1}, {1, BIG}}, {2 * BIG, 2 * BIG}, {BIG, 2 * BIG}, {BIG, BIG}};
+    REQUIRE_THROWS_AS(aoc::ilp::minimize(p), std::overflow_error);
+}
+
+TEST_CASE("ILP on machines with many free buttons", "[ilp]") {
+    // the relaxation's optimum here is 456, a whole face of the polytope without a lattice point
+    std::istringstream iss{"[#..###..] (0,3,4,5) (1,2,3,4,5,6) (1,2,3,5,6,7) (0,1,2,3,4,6,7) "
+                           "(2,3) (1) (0,2,3,4,5,6,7) (6) (3,7) (0,2,3,6,7) (1,2,3,4,5,7) "
+                           "(0,1,3,4,5,6) (0,1,2,3,5,6) {261,325,334,456,220,296,342,182}"};
+    aoc::Problem machine;
+    iss >> machine;
+    REQUIRE(aoc::minPresses(machine) == 457);
+
+    std::mt19937 rng{10};
+    for (int i = 0; i < 40; i++) {
+        auto [p, planted] = plantedMachine(rng, 6 + i % 5, 14 + i % 5, 100);
+        auto s = aoc::ilp::minimize(p);
+        REQUIRE(s);
+        REQUIRE(s->value <= planted);
+        requireSolves(p, *s);
+    }
+}
+
 //NOLINTEND
\ No newline at end of file
@@ -1,9 +1,26 @@
 #include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <sstream>
 #include <stdexcept>
 // NOLINTBEGIN
 #include "rational.hh"
 
 using R = Rational<int>;
+using L = Rational<int64_t>;
+
+namespace
+{
+// small numerators and denominators, so a few operations stay exact in int64_t either way
+L randomRational(std::mt19937_64& rng)
+{
+    std::uniform_int_distribution<int64_t> num{-1000, 1000};
+    std::uniform_int_distribution<int64_t> den{1, 1000};
+    return L{num(rng), den(rng) * (rng() % 2 ? 1 : -1)};
+}
+} // namespace
 
 TEST_CASE("Basic arithmetic")
 {
@@ -133,4 +150,86 @@ TEST_CASE("Mixed rational and integer operations")
     REQUIRE(6 / r == R{12, 1});
 }
 
+TEST_CASE("Field properties hold")
+{
+    std::mt19937_64 rng{2016};
+    for (int i = 0; i < 2000; ++i)
+    {
+        auto a = randomRational(rng);
+        auto b = randomRational(rng);
+        auto c = randomRational(rng);
+        REQUIRE(a + b == b + a);
+        REQUIRE(a * b == b * a);
+        REQUIRE((a + b) + c == a + (b + c));
+        REQUIRE((a * b) * c == a * (b * c));
+        REQUIRE(a * (b + c) == a * b + a * c);
+        REQUIRE(a - a == L{});
+        REQUIRE(a + b - b == a);
+        if (b != L{})
+        {
+            REQUIRE(a / b * b == a);
+        }
+    }
+}
+
+TEST_CASE("Order agrees with subtraction")
+{
+    std::mt19937_64 rng{2017};
+    for (int i = 0; i < 2000; ++i)
+    {
+        auto a = randomRational(rng);
+        auto b = randomRational(rng);
+        REQUIRE((a < b) == (b - a > L{}));
+        REQUIRE((a == b) == (a - b == L{}));
+        REQUIRE(((a < b) + (a == b) + (a > b)) == 1);
+    }
+}
+
+TEST_CASE("Reduced form is canonical")
+{
+    std::mt19937_64 rng{2018};
+    for (int i = 0; i < 2000; ++i)
+    {
+        auto a = randomRational(rng) * randomRational(rng) + randomRational(rng);
+        auto r = a.reduced();
+        REQUIRE(r == a);
+        REQUIRE(r.denominator() > 0);
+        REQUIRE(std::gcd(r.numerator(), r.denominator()) == 1);
+        REQUIRE(a.numerator() == r.numerator());
+        REQUIRE(a.denominator() == r.denominator());
+    }
+    std::ostringstream os;
+    os << R{4, -6} << ' ' << R{8, 4};
+    REQUIRE(os.str() == "-2/3 2");
+}
+
+TEST_CASE("Intermediates wider than T")
+{
+    constexpr auto BIG = std::numeric_limits<int64_t>::max() / 3;
+    // BIG * 5 / BIG and 1/BIG + 1/BIG only fit once reduced
+    REQUIRE(L{BIG} * L{5, BIG} == L{5});
+    REQUIRE(L{1, BIG} + L{1, BIG} == L{2, BIG});
+    REQUIRE(L{BIG, 7} < L{BIG - 1, 7} + L{1});
+    REQUIRE(L{BIG} / L{BIG, 2} == 2);
+}
+
+#ifndef NDEBUG
+TEST_CASE("Overflow throws in debug builds")
+{
+    constexpr auto MAX = std::numeric_limits<int64_t>::max();
+    REQUIRE_THROWS_AS(L{MAX} + L{1}, std::overflow_error);
+    REQUIRE_THROWS_AS(L{MAX} * L{2}, std::overflow_error);
+    REQUIRE_THROWS_AS((L{1, MAX} + L{1, MAX - 1}), std::overflow_error);
+}
+#endif
+
+TEST_CASE("Checked overflow throws in every build")
+{
+    using C = Rational<int64_t, true>;
+    constexpr auto MAX = std::numeric_limits<int64_t>::max();
+    REQUIRE_THROWS_AS(C{MAX} + C{1}, std::overflow_error);
+    REQUIRE_THROWS_AS((C{1, MAX} * C{1, 2}), std::overflow_error);
+    REQUIRE(C{MAX} * C{1, MAX} == C{1});
+}
+
 // NOLINTEND
\ No newline at end of file